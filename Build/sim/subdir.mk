@@ -0,0 +1,24 @@
+################################################################################
+# Automatically-generated file. Do not edit!
+################################################################################
+
+# Add inputs and outputs from these tool invocations to the build variables 
+CPP_SRCS += \
+../sim/Simulator.cpp 
+
+OBJS += \
+./sim/Simulator.o 
+
+CPP_DEPS += \
+./sim/Simulator.d 
+
+
+# Each subdirectory must supply rules for building sources it contributes
+sim/%.o: ../sim/%.cpp
+	@echo 'Building file: $<'
+	@echo 'Invoking: Cross G++ Compiler'
+	g++ -std=c++0x -I"/home/djones/Documentos/Projetos/Posts/Boost.Test LibreRTOS/librertos_test/librertos" -I"/home/djones/Documentos/Projetos/Posts/Boost.Test LibreRTOS/librertos_test/sim" -I"/home/djones/Documentos/Projetos/Posts/Boost.Test LibreRTOS/librertos_test/tests" -O0 -g3 -pedantic -Wall -Wextra -c -fmessage-length=0 -MMD -MP -MF"$(@:%.o=%.d)" -MT"$(@)" -o "$@" "$<"
+	@echo 'Finished building: $<'
+	@echo ' '
+
+
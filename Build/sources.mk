@@ -24,5 +24,6 @@ CPP_DEPS :=
 # Every subdirectory with source files must be described here
 SUBDIRS := \
 librertos \
+sim \
 tests \
 
@@ -5,42 +5,99 @@
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
 ../tests/main.cpp \
+../tests/test_CacheLine.cpp \
+../tests/test_CondVar.cpp \
+../tests/test_Coroutine.cpp \
+../tests/test_Defer.cpp \
+../tests/test_EDF.cpp \
 ../tests/test_Fifo.cpp \
+../tests/test_Heap.cpp \
+../tests/test_Instances.cpp \
+../tests/test_MessageBuffer.cpp \
 ../tests/test_Mutex.cpp \
+../tests/test_Notify.cpp \
 ../tests/test_OSevent.cpp \
 ../tests/test_OSlist.cpp \
+../tests/test_OSlistCompact.cpp \
+../tests/test_Objects.cpp \
+../tests/test_Pool.cpp \
+../tests/test_Profile.cpp \
 ../tests/test_Queue.cpp \
+../tests/test_QueueLockFree.cpp \
+../tests/test_RwLock.cpp \
 ../tests/test_Scheduler.cpp \
 ../tests/test_Semaphore.cpp \
+../tests/test_Simulator.cpp \
+../tests/test_Statistics.cpp \
 ../tests/test_Timer.cpp \
+../tests/test_Trace.cpp \
+../tests/test_WorkStealing.cpp \
 ../tests/test_func__OS_scheduler.cpp \
 ../tests/test_func__OS_schedulerUnlock.cpp \
 ../tests/test_func__OS_taskDelay.cpp 
 
 OBJS += \
 ./tests/main.o \
+./tests/test_CacheLine.o \
+./tests/test_CondVar.o \
+./tests/test_Coroutine.o \
+./tests/test_Defer.o \
+./tests/test_EDF.o \
 ./tests/test_Fifo.o \
+./tests/test_Heap.o \
+./tests/test_Instances.o \
+./tests/test_MessageBuffer.o \
 ./tests/test_Mutex.o \
+./tests/test_Notify.o \
 ./tests/test_OSevent.o \
 ./tests/test_OSlist.o \
+./tests/test_OSlistCompact.o \
+./tests/test_Objects.o \
+./tests/test_Pool.o \
+./tests/test_Profile.o \
 ./tests/test_Queue.o \
+./tests/test_QueueLockFree.o \
+./tests/test_RwLock.o \
 ./tests/test_Scheduler.o \
 ./tests/test_Semaphore.o \
+./tests/test_Simulator.o \
+./tests/test_Statistics.o \
 ./tests/test_Timer.o \
+./tests/test_Trace.o \
+./tests/test_WorkStealing.o \
 ./tests/test_func__OS_scheduler.o \
 ./tests/test_func__OS_schedulerUnlock.o \
 ./tests/test_func__OS_taskDelay.o 
 
 CPP_DEPS += \
 ./tests/main.d \
+./tests/test_CacheLine.d \
+./tests/test_CondVar.d \
+./tests/test_Coroutine.d \
+./tests/test_Defer.d \
+./tests/test_EDF.d \
 ./tests/test_Fifo.d \
+./tests/test_Heap.d \
+./tests/test_Instances.d \
+./tests/test_MessageBuffer.d \
 ./tests/test_Mutex.d \
+./tests/test_Notify.d \
 ./tests/test_OSevent.d \
 ./tests/test_OSlist.d \
+./tests/test_OSlistCompact.d \
+./tests/test_Objects.d \
+./tests/test_Pool.d \
+./tests/test_Profile.d \
 ./tests/test_Queue.d \
+./tests/test_QueueLockFree.d \
+./tests/test_RwLock.d \
 ./tests/test_Scheduler.d \
 ./tests/test_Semaphore.d \
+./tests/test_Simulator.d \
+./tests/test_Statistics.d \
 ./tests/test_Timer.d \
+./tests/test_Trace.d \
+./tests/test_WorkStealing.d \
 ./tests/test_func__OS_scheduler.d \
 ./tests/test_func__OS_schedulerUnlock.d \
 ./tests/test_func__OS_taskDelay.d 
@@ -50,7 +107,7 @@ CPP_DEPS += \
 tests/%.o: ../tests/%.cpp
 	@echo 'Building file: $<'
 	@echo 'Invoking: Cross G++ Compiler'
-	g++ -std=c++0x -I"/home/djones/Documentos/Projetos/Posts/Boost.Test LibreRTOS/librertos_test/librertos" -I"/home/djones/Documentos/Projetos/Posts/Boost.Test LibreRTOS/librertos_test/tests" -O0 -g3 -pedantic -Wall -Wextra -c -fmessage-length=0 -MMD -MP -MF"$(@:%.o=%.d)" -MT"$(@)" -o "$@" "$<"
+	g++ -std=c++0x -I"/home/djones/Documentos/Projetos/Posts/Boost.Test LibreRTOS/librertos_test/librertos" -I"/home/djones/Documentos/Projetos/Posts/Boost.Test LibreRTOS/librertos_test/sim" -I"/home/djones/Documentos/Projetos/Posts/Boost.Test LibreRTOS/librertos_test/tests" -I"/home/djones/Documentos/Projetos/Posts/Boost.Test LibreRTOS/librertos_test/cpp" -O0 -g3 -pedantic -Wall -Wextra -c -fmessage-length=0 -MMD -MP -MF"$(@:%.o=%.d)" -MT"$(@)" -o "$@" "$<"
 	@echo 'Finished building: $<'
 	@echo ' '
 
@@ -0,0 +1,38 @@
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#include <chrono>
+#include <cstdio>
+
+/* Time statistics of a benchmarked operation, in nanoseconds. */
+struct BenchResult {
+  double Average;
+  double Max;
+};
+
+/* Call func() n times, timing each call. */
+template <class Func> BenchResult benchRun(unsigned long n, Func func) {
+  typedef std::chrono::steady_clock clock;
+  BenchResult result = {0.0, 0.0};
+
+  for (unsigned long i = 0; i < n; ++i) {
+    clock::time_point start = clock::now();
+    func();
+    clock::time_point end = clock::now();
+
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    result.Average += ns;
+    if (ns > result.Max)
+      result.Max = ns;
+  }
+
+  result.Average /= (double)n;
+  return result;
+}
+
+inline void benchReport(const char *name, const BenchResult &result) {
+  std::printf("%-32s avg %10.1f ns   max %10.1f ns\n", name, result.Average,
+              result.Max);
+}
+
+#endif /* BENCH_H_ */
@@ -0,0 +1,128 @@
+#include "LibreRTOS.h"
+#include "bench.h"
+#include <thread>
+
+/* Contention between the producer and consumer sides of the kernel objects,
+ and between the tick and the scheduler sides of OSstate, when each side runs
+ in its own host thread. Compare the compact and the padded layouts:
+
+ run_bench.sh bench_FalseSharing "-pthread" \
+     "-DLIBRERTOS_CACHE_LINE_SIZE=64 -pthread"
+
+ Build with -DLIBRERTOS_QUEUE_LOCKFREE=1 to also time a lock-free queue
+ written and read by two threads. */
+
+static const unsigned long NumIterations = 20000000UL;
+
+/* Run both functions n times, each in its own thread, and return the time
+ per iteration in nanoseconds. */
+template <class FuncA, class FuncB>
+double benchPair(unsigned long n, FuncA funcA, FuncB funcB) {
+  typedef std::chrono::steady_clock clock;
+
+  clock::time_point start = clock::now();
+
+  std::thread threadA([&]() {
+    for (unsigned long i = 0; i < n; ++i)
+      funcA(i);
+  });
+  std::thread threadB([&]() {
+    for (unsigned long i = 0; i < n; ++i)
+      funcB(i);
+  });
+  threadA.join();
+  threadB.join();
+
+  clock::time_point end = clock::now();
+
+  return std::chrono::duration<double, std::nano>(end - start).count() /
+         (double)n;
+}
+
+static void pairReport(const char *name, double ns) {
+  std::printf("%-32s %10.2f ns/iteration\n", name, ns);
+}
+
+static void benchFifoFields(void) {
+  static struct Fifo_t fifo;
+  static uint8_t buff[16];
+
+  Fifo_init(&fifo, &buff[0], (len_t)sizeof(buff));
+
+  /* Only the fields of each side, the objects are not thread safe. */
+  volatile len_t *wlock = &fifo.WLock;
+  volatile len_t *free = &fifo.Free;
+  volatile len_t *rlock = &fifo.RLock;
+  volatile len_t *used = &fifo.Used;
+
+  pairReport("Fifo_t producer/consumer",
+             benchPair(
+                 NumIterations,
+                 [&](unsigned long i) {
+                   *wlock = (len_t)i;
+                   *free = (len_t)(*free + 1);
+                 },
+                 [&](unsigned long i) {
+                   *rlock = (len_t)i;
+                   *used = (len_t)(*used + 1);
+                 }));
+}
+
+static void benchStateFields(void) {
+  OS_init();
+  OS_start();
+
+  volatile tick_t *tick = &OSstate.Tick;
+  volatile tick_t *delayedTicks = &OSstate.DelayedTicks;
+  volatile schedulerLock_t *schedulerLock = &OSstate.SchedulerLock;
+  struct task_t *volatile *task = &OSstate.Task[0];
+
+  pairReport("OSstate tick/scheduler",
+             benchPair(
+                 NumIterations,
+                 [&](unsigned long i) {
+                   *tick = (tick_t)i;
+                   *delayedTicks = (tick_t)(*delayedTicks + 1);
+                 },
+                 [&](unsigned long i) {
+                   *schedulerLock = (schedulerLock_t)i;
+                   (void)task[i % LIBRERTOS_MAX_PRIORITY];
+                 }));
+}
+
+#if (LIBRERTOS_QUEUE_LOCKFREE != 0)
+static void benchQueueLockFree(void) {
+  static uint32_t cells[QUEUE_LOCKFREE_SIZE(64, sizeof(uint32_t)) /
+                        sizeof(uint32_t)];
+  static struct Queue_t que;
+
+  Queue_initLockFree(&que, &cells[0], 64, (len_t)sizeof(uint32_t));
+
+  pairReport("Queue lock-free write/read",
+             benchPair(
+                 NumIterations / 10,
+                 [&](unsigned long i) {
+                   uint32_t x = (uint32_t)i;
+                   while (!Queue_write(&que, &x)) {
+                   }
+                 },
+                 [&](unsigned long i) {
+                   uint32_t x;
+                   (void)i;
+                   while (!Queue_read(&que, &x)) {
+                   }
+                 }));
+}
+#endif
+
+int main() {
+  std::printf("cache line: %u bytes\n", (unsigned)LIBRERTOS_CACHE_LINE_SIZE);
+
+  benchFifoFields();
+  benchStateFields();
+#if (LIBRERTOS_QUEUE_LOCKFREE != 0)
+  benchQueueLockFree();
+#endif
+
+  return 0;
+}
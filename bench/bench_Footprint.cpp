@@ -0,0 +1,102 @@
+#include "LibreRTOS.h"
+#include "bench.h"
+#include <cstring>
+
+/* Cost of the core kernel operations in the current configuration, printed as
+ one tab separated row (or the header with -h). scripts/footprint_report.sh
+ builds it for every configuration, next to the object and module sizes. */
+
+static const unsigned long NumCalls = 100000UL;
+
+static struct task_t Task;
+static struct Semaphore_t Sem;
+static struct Mutex_t Mtx;
+static struct Fifo_t Fif;
+static struct Queue_t Que;
+static uint8_t FifBuff[16];
+static uint32_t QueBuff[4];
+
+static void taskDelayLong(taskParameter_t param) {
+  (void)param;
+  OS_taskDelay(1000);
+}
+
+static void printHeader(void) {
+  std::printf("tick_ns\tdelay_ns\tsem_ns\t");
+#if (LIBRERTOS_NOTIFICATIONS != 0)
+  std::printf("notify_ns\t");
+#endif
+  std::printf("mutex_ns\tfifo_ns\tqueue_ns\n");
+}
+
+static void printTime(const BenchResult &result, const char *end) {
+  std::printf("%.1f%s", result.Average, end);
+}
+
+static void benchOperations(void) {
+  OS_init();
+  OS_taskCreate(&Task, 0, &taskDelayLong, NULL);
+  Semaphore_init(&Sem, 0, 1);
+  Mutex_init(&Mtx);
+  Fifo_init(&Fif, &FifBuff[0], (len_t)sizeof(FifBuff));
+  Queue_init(&Que, &QueBuff[0], 4, (len_t)sizeof(QueBuff[0]));
+  OS_start();
+  OS_scheduler();
+
+  /* Task delayed most of the time, as in an idle system. */
+  printTime(benchRun(NumCalls, []() {
+    OS_tick();
+    OS_scheduler();
+  }), "\t");
+
+  /* Ready, so each delay takes the task out of the ready state. */
+  OS_taskResume(&Task);
+  OSstate.CurrentTCB = &Task;
+
+  printTime(benchRun(NumCalls, []() {
+    OS_taskDelay(10);
+    OS_taskResume(&Task);
+  }), "\t");
+
+  printTime(benchRun(NumCalls, []() {
+    Semaphore_give(&Sem);
+    Semaphore_take(&Sem);
+  }), "\t");
+
+#if (LIBRERTOS_NOTIFICATIONS != 0)
+  printTime(benchRun(NumCalls, []() {
+    OS_taskNotify(&Task, 1, NOTIFY_INCREMENT);
+    OS_taskNotifyTake(NULL, ~(notify_t)0);
+  }), "\t");
+#endif
+
+  printTime(benchRun(NumCalls, []() {
+    Mutex_lock(&Mtx);
+    Mutex_unlock(&Mtx);
+  }), "\t");
+
+  printTime(benchRun(NumCalls, []() {
+    uint8_t x = 0;
+    Fifo_write(&Fif, &x, 1);
+    Fifo_read(&Fif, &x, 1);
+  }), "\t");
+
+  printTime(benchRun(NumCalls, []() {
+    uint32_t x = 0;
+    Queue_write(&Que, &x);
+    Queue_read(&Que, &x);
+  }), "\n");
+
+  OSstate.CurrentTCB = NULL;
+}
+
+int main(int argc, char *argv[]) {
+  if (argc > 1 && std::strcmp(argv[1], "-h") == 0) {
+    printHeader();
+    return 0;
+  }
+
+  benchOperations();
+
+  return 0;
+}
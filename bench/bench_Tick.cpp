@@ -0,0 +1,98 @@
+#include "LibreRTOS.h"
+#include "bench.h"
+
+/* Cost of the tick dependent kernel operations. Build once per tick width
+ (LIBRERTOS_TICK_BITS) with scripts/run_bench.sh to compare them. The max
+ time of OS_tick shows the spikes caused by tick count overflows. Built with
+ and without LIBRERTOS_TRACE the difference is the cost of the trace records:
+ one per tick and per kernel object operation, two per task dispatch. */
+
+static const unsigned long NumTicks = 1000000UL;
+static const unsigned long NumCalls = 100000UL;
+
+static struct task_t Tasks[LIBRERTOS_MAX_PRIORITY - 1];
+static struct Timer_t Timers[8];
+static struct Semaphore_t Sem;
+
+static void taskDelayPriority(taskParameter_t param) {
+  /* Each task wakes up with a different period. */
+  OS_taskDelay((tick_t)(1 + (priority_t)(long)param));
+}
+
+static void timerFunction(struct Timer_t *timer, void *param) {
+  (void)timer;
+  (void)param;
+}
+
+static void benchTick(void) {
+  OS_init();
+  for (priority_t i = 0; i < LIBRERTOS_MAX_PRIORITY - 1; ++i)
+    OS_taskCreate(&Tasks[i], i, &taskDelayPriority, (taskParameter_t)(long)i);
+  OS_start();
+  OS_scheduler();
+
+  benchReport("OS_tick+OS_scheduler", benchRun(NumTicks, []() {
+                OS_tick();
+                OS_scheduler();
+              }));
+}
+
+static void benchTaskDelay(void) {
+  OS_init();
+  OS_taskCreate(&Tasks[0], 0, NULL, NULL);
+  OS_start();
+  OSstate.CurrentTCB = &Tasks[0];
+
+  benchReport("OS_taskDelay+OS_taskResume", benchRun(NumCalls, []() {
+                OS_taskDelay(10);
+                OS_taskResume(&Tasks[0]);
+              }));
+
+  OSstate.CurrentTCB = NULL;
+}
+
+static void benchTimer(void) {
+  OS_init();
+  OS_timerTaskCreate(LIBRERTOS_MAX_PRIORITY - 1);
+  for (unsigned i = 0; i < sizeof(Timers) / sizeof(Timers[0]); ++i)
+    Timer_init(&Timers[i], TIMERTYPE_AUTO, (tick_t)(i + 1), &timerFunction,
+               NULL);
+  OS_start();
+
+  for (unsigned i = 0; i < sizeof(Timers) / sizeof(Timers[0]); ++i)
+    Timer_start(&Timers[i]);
+  OS_scheduler();
+
+  benchReport("Timer tick+callbacks", benchRun(NumTicks, []() {
+                OS_tick();
+                OS_scheduler();
+              }));
+
+  benchReport("Timer_reset+merge", benchRun(NumCalls, []() {
+                Timer_reset(&Timers[0]);
+                OS_scheduler();
+              }));
+}
+
+static void benchSemaphore(void) {
+  OS_init();
+  Semaphore_init(&Sem, 0, 1);
+  OS_start();
+
+  benchReport("Semaphore_give+Semaphore_take", benchRun(NumCalls, []() {
+                Semaphore_give(&Sem);
+                Semaphore_take(&Sem);
+              }));
+}
+
+int main() {
+  std::printf("tick_t: %u bits\n", (unsigned)(sizeof(tick_t) * 8));
+  std::printf("trace: %s\n", LIBRERTOS_TRACE != 0 ? "on" : "off");
+
+  benchTick();
+  benchTaskDelay();
+  benchTimer();
+  benchSemaphore();
+
+  return 0;
+}
@@ -0,0 +1,24 @@
+#include "projdefs.h"
+#include <chrono>
+#include <cstdlib>
+
+/* Port functions required by projdefs.h, without the test-only behavior. */
+
+void myassert(int x) {
+  if (x == 0)
+    std::abort();
+}
+
+void librertos_test_set_concurrent_behavior(void (*f)(void)) { (void)f; }
+
+void librertos_test_concurrent_access(void) {}
+
+extern "C" stattime_t US_systemRunTime(void) {
+  typedef std::chrono::steady_clock clock;
+  static const clock::time_point start = clock::now();
+  return (stattime_t)std::chrono::duration_cast<std::chrono::microseconds>(
+             clock::now() - start)
+      .count();
+}
+
+extern "C" void US_idleHook(tick_t ticks) { (void)ticks; }
@@ -0,0 +1,188 @@
+/*
+ Copyright 2016 Djones A. Boni
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+/* Production configuration measured by scripts/footprint_report.sh. Unlike
+ tests/projdefs.h the optional features are disabled, asserts are compiled out
+ and there is no test hook. Every option can be overridden with -D. */
+
+#ifndef PROJDEFS_H_
+#define PROJDEFS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* LibreRTOS definitions. */
+#ifndef LIBRERTOS_TICK_BITS
+#define LIBRERTOS_TICK_BITS 16     /* 16, 32 or 64 */
+#endif
+#ifndef LIBRERTOS_MAX_PRIORITY
+#define LIBRERTOS_MAX_PRIORITY 10  /* integer > 0 */
+#endif
+#ifndef LIBRERTOS_PREEMPTION
+#define LIBRERTOS_PREEMPTION 0     /* boolean */
+#endif
+#ifndef LIBRERTOS_PREEMPT_LIMIT
+#define LIBRERTOS_PREEMPT_LIMIT 0  /* integer >= 0, < LIBRERTOS_MAX_PRIORITY */
+#endif
+#ifndef LIBRERTOS_SOFTWARETIMERS
+#define LIBRERTOS_SOFTWARETIMERS 1 /* boolean */
+#endif
+#ifndef LIBRERTOS_STATE_GUARDS
+#define LIBRERTOS_STATE_GUARDS 0   /* boolean */
+#endif
+#ifndef LIBRERTOS_STATISTICS
+#define LIBRERTOS_STATISTICS 0     /* boolean */
+#endif
+#ifndef LIBRERTOS_TIMER_MERGE_QUOTA
+#define LIBRERTOS_TIMER_MERGE_QUOTA 2 /* integer >= 0, 0 = unbounded */
+#endif
+#ifndef LIBRERTOS_TRACE
+#define LIBRERTOS_TRACE 0          /* boolean */
+#endif
+#ifndef LIBRERTOS_TRACE_LENGTH
+#define LIBRERTOS_TRACE_LENGTH 32  /* integer power of 2 */
+#endif
+#ifndef LIBRERTOS_COMPACT_LISTS
+#define LIBRERTOS_COMPACT_LISTS 0  /* 0 (pointers), 8 or 16 (index bits) */
+#endif
+#ifndef LIBRERTOS_MAX_TIMERS
+#define LIBRERTOS_MAX_TIMERS 8     /* integer > 0, with compact lists */
+#endif
+#ifndef LIBRERTOS_HEAP
+#define LIBRERTOS_HEAP 0           /* boolean */
+#endif
+#ifndef LIBRERTOS_DEFER_LENGTH
+#define LIBRERTOS_DEFER_LENGTH 0   /* integer power of 2, 0 = disabled */
+#endif
+#ifndef LIBRERTOS_PROFILE_CRITICAL
+#define LIBRERTOS_PROFILE_CRITICAL 0 /* boolean */
+#endif
+#ifndef LIBRERTOS_PROFILE_SITES
+#define LIBRERTOS_PROFILE_SITES 32 /* integer > 0 */
+#endif
+#ifndef LIBRERTOS_PROFILE_BINS
+#define LIBRERTOS_PROFILE_BINS 8   /* integer > 1 */
+#endif
+#ifndef LIBRERTOS_NOTIFICATIONS
+#define LIBRERTOS_NOTIFICATIONS 0  /* boolean */
+#endif
+#ifndef LIBRERTOS_MULTIPLE_INSTANCES
+#define LIBRERTOS_MULTIPLE_INSTANCES 0 /* boolean */
+#endif
+#ifndef LIBRERTOS_WORK_STEALING
+#define LIBRERTOS_WORK_STEALING 0 /* boolean, with multiple instances */
+#endif
+#ifndef LIBRERTOS_MAX_INSTANCES
+#define LIBRERTOS_MAX_INSTANCES 4      /* integer > 0, with work stealing */
+#endif
+#ifndef LIBRERTOS_WORK_DEQUE_LENGTH
+#define LIBRERTOS_WORK_DEQUE_LENGTH 64 /* integer power of 2 */
+#endif
+#ifndef LIBRERTOS_QUEUE_LOCKFREE
+#define LIBRERTOS_QUEUE_LOCKFREE 0 /* boolean */
+#endif
+#ifndef LIBRERTOS_CACHE_LINE_SIZE
+#define LIBRERTOS_CACHE_LINE_SIZE 0 /* integer power of 2, 0 = compact */
+#endif
+#ifndef LIBRERTOS_IDLE_HOOK
+#define LIBRERTOS_IDLE_HOOK 0 /* boolean */
+#endif
+#ifndef LIBRERTOS_EDF
+#define LIBRERTOS_EDF 0 /* boolean */
+#endif
+
+typedef int8_t priority_t;
+typedef uint8_t schedulerLock_t;
+#if (LIBRERTOS_TICK_BITS == 64)
+typedef uint64_t tick_t;
+typedef int64_t difftick_t;
+#elif (LIBRERTOS_TICK_BITS == 32)
+typedef uint32_t tick_t;
+typedef int32_t difftick_t;
+#else
+typedef uint16_t tick_t;
+typedef int16_t difftick_t;
+#endif
+typedef uint32_t stattime_t;
+typedef uint32_t statcount_t;
+typedef int16_t len_t;
+typedef uint8_t bool_t;
+typedef uint32_t notify_t;
+
+#define MAX_DELAY ((tick_t)-1)
+
+/* Port macros of the multi-core options, unused by default. */
+#define LIBRERTOS_THREAD_LOCAL __thread
+#define MEMORY_BARRIER() __sync_synchronize()
+#define COMPARE_AND_SWAP(ptr, old, new)                                        \
+  __sync_bool_compare_and_swap(ptr, old, new)
+#define ALIGNED(n) __attribute__((aligned(n)))
+
+/* Assert macro, compiled out. */
+#define ASSERT(x) ((void)0)
+
+/* Enable/disable interrupts macros. */
+#define INTERRUPTS_ENABLE()                                                    \
+  do {                                                                         \
+    volatile int x = 0;                                                        \
+    ++x;                                                                       \
+  } while (0)
+#define INTERRUPTS_DISABLE()                                                   \
+  do {                                                                         \
+    volatile int x = 0;                                                        \
+    ++x;                                                                       \
+  } while (0)
+
+/* Nested critical section management macros. */
+#define CRITICAL_VAL() int _cpu_state = 0
+#if (LIBRERTOS_PROFILE_CRITICAL != 0)
+/* Record hold time of the outermost critical section per call site. */
+void OS_profileCriticalEnter(const char *file, int line);
+void OS_profileCriticalExit(void);
+#define CRITICAL_ENTER()                                                       \
+  do {                                                                         \
+    ++_cpu_state;                                                              \
+    OS_profileCriticalEnter(__FILE__, __LINE__);                               \
+  } while (0)
+#define CRITICAL_EXIT()                                                        \
+  do {                                                                         \
+    OS_profileCriticalExit();                                                  \
+    --_cpu_state;                                                              \
+  } while (0)
+#else
+#define CRITICAL_ENTER()                                                       \
+  do {                                                                         \
+    ++_cpu_state;                                                              \
+  } while (0)
+#define CRITICAL_EXIT()                                                        \
+  do {                                                                         \
+    --_cpu_state;                                                              \
+  } while (0)
+#endif
+
+/* No simulated concurrent access. */
+#define LIBRERTOS_TEST_CONCURRENT_ACCESS()                                     \
+  do {                                                                         \
+  } while (0)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PROJDEFS_H_ */
@@ -0,0 +1,280 @@
+#ifndef COROUTINE_H_
+#define COROUTINE_H_
+
+#include "LibreRTOS.h"
+
+#if (__cplusplus >= 202002L)
+
+#include <coroutine>
+#include <exception>
+#include <type_traits>
+
+/* C++20 coroutine tasks.
+
+ A LibreRTOS task is a function run to completion by OS_scheduler(). A
+ protocol with several waits becomes a state machine that decodes its state
+ on every activation. With this header the task body is a coroutine, that
+ co_awaits the kernel objects and is resumed where it stopped:
+
+   Coroutine producer(struct Queue_t *que) {
+     for (;;) {
+       uint32_t x;
+       if (co_await coQueueRead(que, &x, 10))
+         process(x);
+       else
+         timeout();
+     }
+   }
+
+   CoroutineTask task;
+   task.create(priority, producer(&que));
+
+ Each await maps onto the *Pend() call of the object: if it can complete at
+ once the coroutine does not suspend, otherwise the task is pended and the
+ coroutine is suspended. When the task is unblocked the operation is tried
+ again before resuming, so a task woken for data that another task took
+ pends again with the remaining ticks, instead of resuming. The await
+ returns the result of the operation, zero on timeout.
+
+ The coroutine frame is allocated with operator new when the body is
+ called. A body that returns suspends its task. */
+
+class CoroutineTask;
+
+/* Return type of a coroutine task body. */
+class Coroutine {
+public:
+  struct promise_type {
+    CoroutineTask *Runner;
+
+    promise_type() : Runner(NULL) {}
+
+    Coroutine get_return_object() {
+      return Coroutine(
+          std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+    /* Started by the first activation of the task. */
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+
+  Coroutine(Coroutine &&other) : Handle(other.Handle) { other.Handle = {}; }
+  ~Coroutine() {
+    if (Handle)
+      Handle.destroy();
+  }
+
+private:
+  friend class CoroutineTask;
+
+  explicit Coroutine(std::coroutine_handle<promise_type> handle)
+      : Handle(handle) {}
+
+  std::coroutine_handle<promise_type> Handle;
+
+  Coroutine(const Coroutine &);
+  Coroutine &operator=(const Coroutine &);
+};
+
+/* Kernel operation a coroutine is suspended on. */
+class CoAwaiter {
+public:
+  /* Try the operation again, pending the task if it can not complete. Return
+   true if the coroutine can be resumed. */
+  virtual bool poll() = 0;
+
+protected:
+  ~CoAwaiter() {}
+
+  void suspendOn(std::coroutine_handle<Coroutine::promise_type> handle);
+};
+
+/* Kernel task running a coroutine. */
+class CoroutineTask {
+public:
+  struct task_t Task;
+
+  CoroutineTask() : Handle(), Waiting(NULL) { OS_eventRInit(&Finished); }
+  ~CoroutineTask() {
+    if (Handle)
+      Handle.destroy();
+  }
+
+  /* Create the task with a body. Can be called only once. */
+  void create(priority_t priority, Coroutine &&body) {
+    ASSERT(!Handle && body.Handle);
+    Handle = body.Handle;
+    body.Handle = {};
+    Handle.promise().Runner = this;
+    OS_taskCreate(&Task, priority, &CoroutineTask::function, this);
+  }
+
+  bool done() const { return Handle && Handle.done(); }
+
+private:
+  friend class CoAwaiter;
+
+  static void function(taskParameter_t param) {
+    CoroutineTask *self = (CoroutineTask *)param;
+
+    if (self->Waiting != NULL) {
+      if (!self->Waiting->poll())
+        return;
+      self->Waiting = NULL;
+    }
+
+    self->Handle.resume();
+
+    if (self->Handle.done()) {
+      /* Nothing else to run, suspend the task. */
+      OS_schedulerLock();
+      OS_eventPrePendTask(&self->Finished.ListRead, &self->Task);
+      OS_eventPendTask(&self->Finished.ListRead, &self->Task, MAX_DELAY);
+      OS_schedulerUnlock();
+    }
+  }
+
+  std::coroutine_handle<Coroutine::promise_type> Handle;
+  CoAwaiter *Waiting;
+  struct eventR_t Finished;
+
+  /* Non copyable, the kernel holds pointers to the task. */
+  CoroutineTask(const CoroutineTask &);
+  CoroutineTask &operator=(const CoroutineTask &);
+};
+
+inline void
+CoAwaiter::suspendOn(std::coroutine_handle<Coroutine::promise_type> handle) {
+  handle.promise().Runner->Waiting = this;
+}
+
+/* Await of an operation done by a *Pend() call, Op(ticks) returning non-zero
+ on success. */
+template <class Op> class CoPend : public CoAwaiter {
+public:
+  CoPend(tick_t ticks, Op op)
+      : Ticks(ticks), Start(0), Result(), Operation(op) {}
+
+  bool await_ready() {
+    Start = OS_getTickCount();
+    return poll();
+  }
+  void await_suspend(std::coroutine_handle<Coroutine::promise_type> handle) {
+    suspendOn(handle);
+  }
+  auto await_resume() const { return Result; }
+
+  bool poll() {
+    tick_t remaining = remainingTicks();
+    Result = Operation(remaining);
+    return Result != 0 || remaining == 0;
+  }
+
+private:
+  tick_t remainingTicks() const {
+    if (Ticks == MAX_DELAY)
+      return MAX_DELAY;
+    tick_t elapsed = (tick_t)(OS_getTickCount() - Start);
+    return elapsed < Ticks ? (tick_t)(Ticks - elapsed) : (tick_t)0;
+  }
+
+  tick_t Ticks;
+  tick_t Start;
+  std::invoke_result_t<Op &, tick_t> Result;
+  Op Operation;
+};
+
+/* Await of a task delay. */
+class CoDelay : public CoAwaiter {
+public:
+  explicit CoDelay(tick_t ticks) : Ticks(ticks) {}
+
+  bool await_ready() {
+    if (Ticks == 0)
+      return true;
+    OS_taskDelay(Ticks);
+    return false;
+  }
+  void await_suspend(std::coroutine_handle<Coroutine::promise_type> handle) {
+    suspendOn(handle);
+  }
+  void await_resume() const {}
+
+  bool poll() { return true; }
+
+private:
+  tick_t Ticks;
+};
+
+/* Await of a periodic delay, returns 0 on overrun (see OS_taskDelayUntil). */
+class CoDelayUntil : public CoAwaiter {
+public:
+  CoDelayUntil(tick_t *lastWake, tick_t period)
+      : LastWake(lastWake), Period(period), Result(0) {}
+
+  bool await_ready() {
+    Result = OS_taskDelayUntil(LastWake, Period);
+    return OSstate.CurrentTCB->State != TASKSTATE_BLOCKED;
+  }
+  void await_suspend(std::coroutine_handle<Coroutine::promise_type> handle) {
+    suspendOn(handle);
+  }
+  bool_t await_resume() const { return Result; }
+
+  bool poll() { return true; }
+
+private:
+  tick_t *LastWake;
+  tick_t Period;
+  bool_t Result;
+};
+
+inline CoDelay coDelay(tick_t ticks) { return CoDelay(ticks); }
+
+inline CoDelayUntil coDelayUntil(tick_t *lastWake, tick_t period) {
+  return CoDelayUntil(lastWake, period);
+}
+
+inline auto coQueueRead(struct Queue_t *que, void *item,
+                        tick_t ticks = MAX_DELAY) {
+  return CoPend(ticks, [que, item](tick_t t) {
+    return Queue_readPend(que, item, t);
+  });
+}
+
+inline auto coQueueWrite(struct Queue_t *que, const void *item,
+                         tick_t ticks = MAX_DELAY) {
+  return CoPend(ticks, [que, item](tick_t t) {
+    return Queue_writePend(que, item, t);
+  });
+}
+
+/* Fifo awaits return the number of bytes read or written. */
+inline auto coFifoRead(struct Fifo_t *fif, void *buff, len_t length,
+                       tick_t ticks = MAX_DELAY) {
+  return CoPend(ticks, [fif, buff, length](tick_t t) {
+    return Fifo_readPend(fif, buff, length, t);
+  });
+}
+
+inline auto coFifoWrite(struct Fifo_t *fif, const void *buff, len_t length,
+                        tick_t ticks = MAX_DELAY) {
+  return CoPend(ticks, [fif, buff, length](tick_t t) {
+    return Fifo_writePend(fif, buff, length, t);
+  });
+}
+
+inline auto coSemaphoreTake(struct Semaphore_t *sem,
+                            tick_t ticks = MAX_DELAY) {
+  return CoPend(ticks, [sem](tick_t t) { return Semaphore_takePend(sem, t); });
+}
+
+inline auto coMutexLock(struct Mutex_t *mtx, tick_t ticks = MAX_DELAY) {
+  return CoPend(ticks, [mtx](tick_t t) { return Mutex_lockPend(mtx, t); });
+}
+
+#endif /* __cplusplus >= 202002L */
+
+#endif /* COROUTINE_H_ */
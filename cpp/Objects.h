@@ -0,0 +1,206 @@
+#ifndef OBJECTS_H_
+#define OBJECTS_H_
+
+#include "LibreRTOS.h"
+#include <type_traits>
+
+/* C++ kernel objects owning their storage.
+
+ Each class holds the C object and its buffer, initialized by the
+ constructor. Sizes are template parameters, so the calls, all inline, pass
+ compile-time constants to the C kernel:
+
+   librertos::Queue<struct Message, 8> que;
+   struct Message msg;
+   if (que.read(msg))
+     ...
+
+ The C objects keep pointers to themselves and to their buffer, which the
+ kernel sets up in the *_init() functions, so the objects are initialized at
+ run time and can not be copied. get() returns the C object, to be used with
+ the C API. */
+
+namespace librertos {
+
+template <len_t N> class Fifo {
+  static_assert(N > 0, "FIFO length must be greater than zero");
+
+public:
+  Fifo() { Fifo_init(&Fif, &Buff[0], N); }
+
+  len_t write(const void *buff, len_t length) {
+    return Fifo_write(&Fif, buff, length);
+  }
+  len_t read(void *buff, len_t length) { return Fifo_read(&Fif, buff, length); }
+
+  len_t writePend(const void *buff, len_t length, tick_t ticks) {
+    return Fifo_writePend(&Fif, buff, length, ticks);
+  }
+  len_t readPend(void *buff, len_t length, tick_t ticks) {
+    return Fifo_readPend(&Fif, buff, length, ticks);
+  }
+  void pendRead(len_t length, tick_t ticks) {
+    Fifo_pendRead(&Fif, length, ticks);
+  }
+  void pendWrite(len_t length, tick_t ticks) {
+    Fifo_pendWrite(&Fif, length, ticks);
+  }
+
+  len_t used() const { return Fifo_used(&Fif); }
+  len_t free() const { return Fifo_free(&Fif); }
+  static len_t length() { return N; }
+
+  struct Fifo_t *get() { return &Fif; }
+
+private:
+  struct Fifo_t Fif;
+  uint8_t Buff[N];
+
+  /* Non copyable, the kernel holds pointers to the object. */
+  Fifo(const Fifo &);
+  Fifo &operator=(const Fifo &);
+};
+
+template <class T, len_t N> class Queue {
+  static_assert(N > 0, "Queue length must be greater than zero");
+  static_assert(std::is_trivially_copyable<T>::value,
+                "Queue items are copied with memcpy()");
+
+public:
+  Queue() { Queue_init(&Que, &Buff[0], N, (len_t)sizeof(T)); }
+
+  bool write(const T &item) { return Queue_write(&Que, &item) != 0; }
+  bool read(T &item) { return Queue_read(&Que, &item) != 0; }
+
+  bool writePend(const T &item, tick_t ticks) {
+    return Queue_writePend(&Que, &item, ticks) != 0;
+  }
+  bool readPend(T &item, tick_t ticks) {
+    return Queue_readPend(&Que, &item, ticks) != 0;
+  }
+  void pendRead(tick_t ticks) { Queue_pendRead(&Que, ticks); }
+  void pendWrite(tick_t ticks) { Queue_pendWrite(&Que, ticks); }
+
+  len_t used() const { return Queue_used(&Que); }
+  len_t free() const { return Queue_free(&Que); }
+  static len_t length() { return N; }
+  static len_t itemSize() { return (len_t)sizeof(T); }
+
+  struct Queue_t *get() { return &Que; }
+
+private:
+  struct Queue_t Que;
+  T Buff[N];
+
+  Queue(const Queue &);
+  Queue &operator=(const Queue &);
+};
+
+template <len_t Max> class Semaphore {
+  static_assert(Max > 0, "Semaphore maximum must be greater than zero");
+
+public:
+  explicit Semaphore(len_t count = 0) { Semaphore_init(&Sem, count, Max); }
+
+  bool take() { return Semaphore_take(&Sem) != 0; }
+  bool give() { return Semaphore_give(&Sem) != 0; }
+
+  bool takePend(tick_t ticks) { return Semaphore_takePend(&Sem, ticks) != 0; }
+  void pend(tick_t ticks) { Semaphore_pend(&Sem, ticks); }
+
+  len_t count() const { return Semaphore_getCount(&Sem); }
+  static len_t max() { return Max; }
+
+  struct Semaphore_t *get() { return &Sem; }
+
+private:
+  struct Semaphore_t Sem;
+
+  Semaphore(const Semaphore &);
+  Semaphore &operator=(const Semaphore &);
+};
+
+class Mutex {
+public:
+  Mutex() { Mutex_init(&Mtx); }
+
+  bool lock() { return Mutex_lock(&Mtx) != 0; }
+  bool unlock() { return Mutex_unlock(&Mtx) != 0; }
+
+  bool lockPend(tick_t ticks) { return Mutex_lockPend(&Mtx, ticks) != 0; }
+  void pend(tick_t ticks) { Mutex_pend(&Mtx, ticks); }
+
+  len_t count() const { return Mutex_getCount(&Mtx); }
+  struct task_t *owner() const { return Mutex_getOwner(&Mtx); }
+
+  struct Mutex_t *get() { return &Mtx; }
+
+private:
+  struct Mutex_t Mtx;
+
+  Mutex(const Mutex &);
+  Mutex &operator=(const Mutex &);
+};
+
+/* Mutex locked in a scope, if it could be locked (or locked with pend and
+ the task pended). Unlocked at the end of the scope. */
+class MutexLock {
+public:
+  explicit MutexLock(Mutex &mtx) : Mtx(mtx), Locked(mtx.lock()) {}
+  MutexLock(Mutex &mtx, tick_t ticks)
+      : Mtx(mtx), Locked(mtx.lockPend(ticks)) {}
+  ~MutexLock() {
+    if (Locked)
+      Mtx.unlock();
+  }
+
+  bool locked() const { return Locked; }
+
+private:
+  Mutex &Mtx;
+  bool Locked;
+
+  MutexLock(const MutexLock &);
+  MutexLock &operator=(const MutexLock &);
+};
+
+#if (LIBRERTOS_SOFTWARETIMERS != 0)
+/* Timer stopped at the end of its scope, so the kernel does not keep it in
+ the timer lists. With compact lists its slot in the timer table is also
+ released, to be used by the next timer initialized. */
+class Timer {
+public:
+  Timer(enum timerType_t type, tick_t period, timerFunction_t func,
+        void *param) {
+    Timer_init(&Tmr, type, period, func, param);
+  }
+  ~Timer() {
+    Timer_stop(&Tmr);
+#if (LIBRERTOS_COMPACT_LISTS != 0)
+    CRITICAL_VAL();
+    CRITICAL_ENTER();
+    for (int i = 0; i < LIBRERTOS_MAX_TIMERS; ++i)
+      if (OSstate.Timer[i] == &Tmr)
+        OSstate.Timer[i] = NULL;
+    CRITICAL_EXIT();
+#endif
+  }
+
+  void start() { Timer_start(&Tmr); }
+  void reset() { Timer_reset(&Tmr); }
+  void stop() { Timer_stop(&Tmr); }
+  bool isRunning() { return Timer_isRunning(&Tmr) != 0; }
+
+  struct Timer_t *get() { return &Tmr; }
+
+private:
+  struct Timer_t Tmr;
+
+  Timer(const Timer &);
+  Timer &operator=(const Timer &);
+};
+#endif
+
+} /* namespace librertos */
+
+#endif /* OBJECTS_H_ */
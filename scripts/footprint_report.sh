@@ -0,0 +1,128 @@
+#!/bin/bash
+# Report the kernel footprint for every combination of the main options.
+# by Djones A. Boni
+#
+# Usage: footprint_report.sh [COMPILER_FLAGS]
+#
+# For each combination of LIBRERTOS_PREEMPTION, LIBRERTOS_SOFTWARETIMERS,
+# LIBRERTOS_STATE_GUARDS and LIBRERTOS_STATISTICS prints one row (tab
+# separated) with:
+#
+# * sizeof the kernel objects and of OSstate, in bytes;
+# * .text/.data/.bss of each kernel module, in bytes;
+# * average time of the core operations on the host (bench_Footprint), in ns.
+#
+# The kernel is configured by bench/footprint/projdefs.h, the production
+# settings without the test hooks and optional features. COMPILER_FLAGS are
+# added to every configuration, for example "-DLIBRERTOS_NOTIFICATIONS=1".
+#
+# The sizes are measured with the compiler in CC (default gcc) and
+# TARGET_CFLAGS (default -Os), so they can be measured for the target with a
+# cross compiler, for example:
+#
+# CC=arm-none-eabi-gcc NM=arm-none-eabi-nm SIZE=arm-none-eabi-size \
+#     TARGET_CFLAGS="-Os -mcpu=cortex-m3 -mthumb" footprint_report.sh
+
+# Repository root directory
+Root="`(cd "$(dirname "$0")/.."; pwd)`"
+
+Extra="$1"
+
+CC="${CC:-gcc}"
+NM="${NM:-nm}"
+SIZE="${SIZE:-size}"
+TARGET_CFLAGS="${TARGET_CFLAGS:--Os}"
+
+INCLUDES="-I$Root/librertos -I$Root/bench/footprint -I$Root/bench"
+
+Output="`mktemp -d`"
+trap 'rm -rf "$Output"' EXIT
+
+Objects="task_t Fifo_t Queue_t Semaphore_t Mutex_t Timer_t"
+
+# One variable per kernel object, their symbol sizes are the object sizes
+cat > "$Output/footprint.c" << EOF
+#include "LibreRTOS.h"
+struct task_t sizeof_task_t;
+struct Fifo_t sizeof_Fifo_t;
+struct Queue_t sizeof_Queue_t;
+struct Semaphore_t sizeof_Semaphore_t;
+struct Mutex_t sizeof_Mutex_t;
+#if (LIBRERTOS_SOFTWARETIMERS != 0)
+struct Timer_t sizeof_Timer_t;
+#endif
+EOF
+
+# Size of a symbol in decimal, "-" if it does not exist
+symbolSize() {
+    local Hex="`"$NM" -S "${@:2}" 2> /dev/null | \
+        awk -v s="$1" '$4 == s { print $2; exit }'`"
+    if [ -n "$Hex" ]; then echo $((16#$Hex)); else echo "-"; fi
+}
+
+Modules=""
+for Source in "$Root"/librertos/*.c; do
+    Modules="$Modules `basename "$Source" .c`"
+done
+
+# Header
+Header="PREEMPTION\tSOFTWARETIMERS\tSTATE_GUARDS\tSTATISTICS"
+for Object in $Objects OSstate; do
+    Header="$Header\t$Object"
+done
+for Module in $Modules; do
+    Header="$Header\t$Module.text\t$Module.data\t$Module.bss"
+done
+printf "%b" "$Header"
+
+# The timing columns are appended once the benchmark is built
+Bench=1
+
+for Preemption in 0 1; do
+for Timers in 0 1; do
+for Guards in 0 1; do
+for Statistics in 0 1; do
+    Config="-DLIBRERTOS_PREEMPTION=$Preemption \
+        -DLIBRERTOS_SOFTWARETIMERS=$Timers \
+        -DLIBRERTOS_STATE_GUARDS=$Guards \
+        -DLIBRERTOS_STATISTICS=$Statistics $Extra"
+
+    rm -f "$Output"/*.o "$Output"/target/*.o
+    mkdir -p "$Output/target"
+
+    # Target build: object and module sizes
+    for Source in "$Root"/librertos/*.c "$Output/footprint.c"; do
+        "$CC" -std=c90 $TARGET_CFLAGS -fno-common $INCLUDES $Config \
+            -c "$Source" -o "$Output/target/`basename "$Source" .c`.o" \
+            || exit 1
+    done
+
+    Row="$Preemption\t$Timers\t$Guards\t$Statistics"
+    for Object in $Objects; do
+        Row="$Row\t`symbolSize sizeof_$Object "$Output/target/footprint.o"`"
+    done
+    Row="$Row\t`symbolSize OSstate "$Output"/target/*.o`"
+    for Module in $Modules; do
+        Row="$Row\t`"$SIZE" -B "$Output/target/$Module.o" | \
+            awk 'NR == 2 { print $1 "\t" $2 "\t" $3 }'`"
+    done
+
+    # Host build: timing of the core operations
+    for Source in "$Root"/librertos/*.c; do
+        gcc -std=c90 -O2 $INCLUDES $Config -c "$Source" \
+            -o "$Output/`basename "$Source" .c`.o" || exit 1
+    done
+    g++ -std=c++0x -O2 $INCLUDES $Config -o "$Output/bench_Footprint" \
+        "$Root/bench/bench_Footprint.cpp" "$Root/bench/bench_port.cpp" \
+        "$Output"/*.o || exit 1
+
+    if [ $Bench = 1 ]; then
+        printf "\t%s\n" "`"$Output/bench_Footprint" -h`"
+        Bench=0
+    fi
+
+    printf "%b\t%s\n" "$Row" "`"$Output/bench_Footprint"`"
+done
+done
+done
+done
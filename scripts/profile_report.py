@@ -0,0 +1,121 @@
+#!/usr/bin/env python
+# Usage: profile_report.py [PROFILE_DUMP] [--top N] [--time-scale N]
+#
+# Print the longest critical sections and scheduler lock holds recorded by
+# the LibreRTOS profiler (LIBRERTOS_PROFILE_CRITICAL), from the CSV written
+# by OS_profileDump().
+#
+# PROFILE_DUMP defaults to STDIN. --top limits the number of sites of each
+# kind (default all). --time-scale is the number of US_systemRunTime() units
+# per microsecond (default 1).
+#
+# Dump format (one line per call site, after a header line):
+#   kind,file,line,count,total,max,bin0,bin1,...
+# kind is 'critical' or 'schedulerlock'. bin0 counts holds of zero time,
+# binN counts holds in [2^(N-1), 2^N) and the last bin everything above.
+# by Djones A. Boni
+
+import csv
+import sys
+
+Kinds = ['critical', 'schedulerlock']
+
+# Width of the histogram bars
+BarWidth = 20
+
+
+def parse(lines):
+	"""Return a dict kind -> list of site dicts."""
+	reader = csv.reader(lines)
+	header = next(reader, None)
+	if header is None or header[:6] != \
+			['kind', 'file', 'line', 'count', 'total', 'max']:
+		raise ValueError('Not a LibreRTOS profile dump')
+
+	sites = {}
+	for row in reader:
+		if not row:
+			continue
+		if len(row) < 7:
+			raise ValueError('Invalid line: %s' % ','.join(row))
+		sites.setdefault(row[0], []).append({
+			'file': row[1],
+			'line': int(row[2]),
+			'count': int(row[3]),
+			'total': int(row[4]),
+			'max': int(row[5]),
+			'bins': [int(x) for x in row[6:]],
+		})
+	return sites
+
+
+def binName(i, numBins):
+	if i <= 1:
+		return '%d' % i
+	if i == numBins - 1:
+		return '>=%d' % (1 << (i - 1))
+	return '%d-%d' % (1 << (i - 1), (1 << i) - 1)
+
+
+def report(kind, sites, top, timeScale, out):
+	sites = sorted(sites, key=lambda s: s['max'], reverse=True)
+	if top is not None:
+		sites = sites[:top]
+
+	out.write('%s (%d sites)\n' % (kind, len(sites)))
+	out.write('%-40s %10s %12s %12s %12s\n' %
+		('site', 'count', 'max', 'mean', 'total'))
+
+	for s in sites:
+		mean = float(s['total']) / s['count'] if s['count'] else 0.0
+		out.write('%-40s %10d %12.2f %12.2f %12.2f\n' % (
+			'%s:%d' % (s['file'], s['line']), s['count'],
+			s['max'] / timeScale, mean / timeScale, s['total'] / timeScale))
+
+		# Histogram of hold times in US_systemRunTime() units
+		peak = max(s['bins']) if s['bins'] else 0
+		for i, n in enumerate(s['bins']):
+			if n == 0:
+				continue
+			bar = '#' * max(1, BarWidth * n // peak)
+			out.write('    %10s | %-*s %d\n' %
+				(binName(i, len(s['bins'])), BarWidth, bar, n))
+	out.write('\n')
+
+
+def main(argv):
+	top = None
+	timeScale = 1.0
+	files = []
+
+	args = iter(argv[1:])
+	for arg in args:
+		if arg == '--top':
+			top = int(next(args))
+		elif arg == '--time-scale':
+			timeScale = float(next(args))
+		else:
+			files.append(arg)
+
+	if len(files) > 1:
+		print("Invalid argument")
+		return -1
+
+	try:
+		if len(files) == 1:
+			with open(files[0]) as fp:
+				sites = parse(fp.read().splitlines())
+		else:
+			sites = parse(sys.stdin.read().splitlines())
+	except ValueError as e:
+		print("error: %s" % e)
+		return -1
+
+	for kind in Kinds + sorted(set(sites) - set(Kinds)):
+		if kind in sites:
+			report(kind, sites[kind], top, timeScale, sys.stdout)
+	return 0
+
+
+if __name__ == '__main__':
+	sys.exit(main(sys.argv))
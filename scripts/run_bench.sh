@@ -0,0 +1,50 @@
+#!/bin/bash
+# Build and run a benchmark once for each configuration.
+# by Djones A. Boni
+#
+# Usage: run_bench.sh BENCHMARK [CONFIGURATION...]
+#
+# BENCHMARK is the name of a source file in the bench directory, without the
+# extension. Each CONFIGURATION is a set of compiler flags (usually -D options
+# overriding projdefs.h) used to build both the kernel and the benchmark.
+#
+# Example:
+# run_bench.sh bench_Tick "-DLIBRERTOS_TICK_BITS=16" "-DLIBRERTOS_TICK_BITS=64"
+
+# Repository root directory
+Root="`(cd "$(dirname "$0")/.."; pwd)`"
+
+# Benchmark name
+Bench="$1"; shift
+
+if [ -z "$Bench" ]; then
+    echo "Usage: $0 BENCHMARK [CONFIGURATION...]"
+    exit 1
+fi
+
+# Without configurations run the projdefs.h defaults
+if [ $# = 0 ]; then
+    set -- ""
+fi
+
+# Optimized build, benchmarks are meaningless with -O0 and --coverage
+CFLAGS="-O2 -I$Root/librertos -I$Root/tests -I$Root/bench"
+
+Output="`mktemp -d`"
+trap 'rm -rf "$Output"' EXIT
+
+for Config in "$@"; do
+    rm -f "$Output"/*.o
+
+    for Source in "$Root"/librertos/*.c; do
+        gcc -std=c90 $CFLAGS $Config -c "$Source" \
+            -o "$Output/`basename "$Source" .c`.o" || exit 1
+    done
+
+    g++ -std=c++0x $CFLAGS $Config -o "$Output/$Bench" \
+        "$Root/bench/$Bench.cpp" "$Root/bench/bench_port.cpp" \
+        "$Output"/*.o || exit 1
+
+    echo; echo "*** $Bench $Config"
+    "$Output/$Bench" || exit 1
+done
@@ -0,0 +1,54 @@
+#!/bin/bash
+# Build and run the tests with another kernel configuration.
+# by Djones A. Boni
+#
+# Usage: run_config_tests.sh COMPILER_FLAGS [TEST_SOURCE...] [-- TEST_ARGS...]
+#
+# COMPILER_FLAGS (usually -D options overriding projdefs.h) are used to build
+# the kernel and the tests. Without TEST_SOURCE all the tests are built,
+# otherwise only the given test sources (main.cpp is always built). TEST_ARGS
+# are passed to the test executable. The tests are built as C++0x, or with the
+# standard in CXXSTD.
+#
+# Examples:
+# run_config_tests.sh "-DLIBRERTOS_TICK_BITS=64"
+# run_config_tests.sh "-DLIBRERTOS_COMPACT_LISTS=8"
+# run_config_tests.sh "-DLIBRERTOS_COMPACT_LISTS=16"
+# CXXSTD=c++20 run_config_tests.sh "" tests/test_Coroutine.cpp
+
+# Repository root directory
+Root="`(cd "$(dirname "$0")/.."; pwd)`"
+
+if [ $# = 0 ]; then
+    echo "Usage: $0 COMPILER_FLAGS [TEST_SOURCE...] [-- TEST_ARGS...]"
+    exit 1
+fi
+
+Config="$1"; shift
+
+Sources=()
+while [ $# != 0 ] && [ "$1" != "--" ]; do
+    Sources+=("$1"); shift
+done
+[ "$1" = "--" ] && shift
+
+if [ ${#Sources[@]} = 0 ]; then
+    Sources=("$Root"/tests/test_*.cpp "$Root"/sim/Simulator.cpp)
+fi
+
+CXXSTD="${CXXSTD:-c++0x}"
+CFLAGS="-O0 -g3 -pedantic -Wall -Wextra -I$Root/librertos -I$Root/sim -I$Root/tests -I$Root/cpp"
+
+Output="`mktemp -d`"
+trap 'rm -rf "$Output"' EXIT
+
+for Source in "$Root"/librertos/*.c; do
+    gcc -std=c90 $CFLAGS $Config -c "$Source" \
+        -o "$Output/`basename "$Source" .c`.o" || exit 1
+done
+
+g++ -std=$CXXSTD $CFLAGS $Config -o "$Output/librertos_test" \
+    "$Root/tests/main.cpp" "${Sources[@]}" "$Output"/*.o \
+    -lboost_unit_test_framework || exit 1
+
+"$Output/librertos_test" --log_level=warning "$@"
@@ -0,0 +1,42 @@
+#!/bin/bash
+# Build the simulator and run a workload script.
+# by Djones A. Boni
+#
+# Usage: run_sim.sh WORKLOAD [TICKS] [-- COMPILER_FLAGS...]
+#
+# Compiler flags (usually -D options overriding projdefs.h) are used to build
+# both the kernel and the simulator.
+#
+# Example:
+# run_sim.sh sim/gateway.sim 100000 -- -DLIBRERTOS_TICK_BITS=32
+
+# Repository root directory
+Root="`(cd "$(dirname "$0")/.."; pwd)`"
+
+Args=()
+while [ $# != 0 ] && [ "$1" != "--" ]; do
+    Args+=("$1"); shift
+done
+[ "$1" = "--" ] && shift
+Config="$*"
+
+if [ ${#Args[@]} = 0 ]; then
+    echo "Usage: $0 WORKLOAD [TICKS] [-- COMPILER_FLAGS...]"
+    exit 1
+fi
+
+CFLAGS="-O2 -I$Root/librertos -I$Root/tests -I$Root/sim"
+
+Output="`mktemp -d`"
+trap 'rm -rf "$Output"' EXIT
+
+for Source in "$Root"/librertos/*.c; do
+    gcc -std=c90 $CFLAGS $Config -c "$Source" \
+        -o "$Output/`basename "$Source" .c`.o" || exit 1
+done
+
+g++ -std=c++0x $CFLAGS $Config -o "$Output/librertos_sim" \
+    "$Root/sim/librertos_sim.cpp" "$Root/sim/Simulator.cpp" \
+    "$Root/bench/bench_port.cpp" "$Output"/*.o || exit 1
+
+"$Output/librertos_sim" "${Args[@]}"
@@ -0,0 +1,186 @@
+#!/usr/bin/env python
+# Usage: trace_2_chrome_json.py [TRACE_DUMP [JSON_OUTPUT]] [--time-scale N]
+#
+# Convert a LibreRTOS trace dump, written by OS_traceDump(), into the Chrome
+# trace event JSON format, which can be opened with chrome://tracing or
+# https://ui.perfetto.dev
+#
+# TRACE_DUMP defaults to STDIN and JSON_OUTPUT to STDOUT. N is the number of
+# US_systemRunTime() units per microsecond (default 1).
+#
+# Dump format (fields in the byte order of the target):
+#   Header: 'LRTT' (4 bytes)
+#           version (1 byte)
+#           sizeof(stattime_t) (1 byte)
+#           sizeof(void *) (1 byte)
+#           sizeof(priority_t) (1 byte)
+#           0x0102 (2 bytes, gives the byte order)
+#   Record: time (stattime_t)
+#           object (void *)
+#           event (1 byte)
+#           task priority (priority_t, -1 if no task)
+# by Djones A. Boni
+
+import json
+import struct
+import sys
+
+# Must match enum traceEvent_t in OStrace.h
+Events = [
+	'NONE',
+	'TICK',
+	'TASK_BEGIN',
+	'TASK_END',
+	'PEND',
+	'UNBLOCK',
+	'TIMER_BEGIN',
+	'TIMER_END',
+	'FIFO_WRITE',
+	'FIFO_READ',
+	'QUEUE_WRITE',
+	'QUEUE_READ',
+	'SEMAPHORE_GIVE',
+	'SEMAPHORE_TAKE',
+	'MUTEX_LOCK',
+	'MUTEX_UNLOCK',
+]
+
+HeaderFormat = '4sBBBB'
+Version = 1
+
+# Thread id of events without a task
+KernelTid = -1
+
+UnsignedFormat = {1: 'B', 2: 'H', 4: 'I', 8: 'Q'}
+SignedFormat = {1: 'b', 2: 'h', 4: 'i', 8: 'q'}
+
+
+def parse(data):
+	"""Return a list of (time, object, event, task) tuples."""
+	headerSize = struct.calcsize(HeaderFormat)
+	if len(data) < headerSize + 2:
+		raise ValueError('File too short')
+
+	magic, version, timeSize, pointerSize, prioritySize = \
+		struct.unpack_from(HeaderFormat, data, 0)
+	if magic != b'LRTT':
+		raise ValueError('Not a LibreRTOS trace dump')
+	if version != Version:
+		raise ValueError('Unsupported dump version %d' % version)
+
+	if data[headerSize:headerSize + 2] == b'\x01\x02':
+		order = '>'
+	elif data[headerSize:headerSize + 2] == b'\x02\x01':
+		order = '<'
+	else:
+		raise ValueError('Invalid byte order mark')
+
+	recordFormat = order + UnsignedFormat[timeSize] + \
+		UnsignedFormat[pointerSize] + 'B' + SignedFormat[prioritySize]
+	recordSize = struct.calcsize(recordFormat)
+
+	records = []
+	pos = headerSize + 2
+	last = 0
+	wraps = 0
+	while pos + recordSize <= len(data):
+		time, obj, event, task = struct.unpack_from(recordFormat, data, pos)
+		pos += recordSize
+
+		# Unwrap the run time counter overflow
+		if time < last:
+			wraps += 1
+		last = time
+		time += wraps << (8 * timeSize)
+
+		records.append((time, obj, event, task))
+	return records
+
+
+def eventName(event):
+	if event < len(Events):
+		return Events[event]
+	return 'EVENT_%d' % event
+
+
+def convert(records, timeScale):
+	traceEvents = []
+	tids = set()
+
+	for time, obj, event, task in records:
+		name = eventName(event)
+		tid = task if task >= 0 else KernelTid
+		tids.add(tid)
+
+		ev = {
+			'name': name,
+			'pid': 1,
+			'tid': tid,
+			'ts': float(time) / timeScale,
+			'args': {'object': '0x%x' % obj},
+		}
+
+		if name == 'TASK_BEGIN':
+			ev.update(name='task %d' % task, ph='B')
+		elif name == 'TASK_END':
+			ev.update(name='task %d' % task, ph='E')
+		elif name == 'TIMER_BEGIN':
+			ev.update(name='timer 0x%x' % obj, ph='B')
+		elif name == 'TIMER_END':
+			ev.update(name='timer 0x%x' % obj, ph='E')
+		else:
+			ev.update(ph='i', s='t')
+
+		traceEvents.append(ev)
+
+	# Name the timeline rows
+	for tid in sorted(tids):
+		traceEvents.append({
+			'name': 'thread_name',
+			'ph': 'M',
+			'pid': 1,
+			'tid': tid,
+			'args': {'name': 'kernel' if tid == KernelTid
+				else 'priority %d' % tid},
+		})
+
+	return {'traceEvents': traceEvents, 'displayTimeUnit': 'ns'}
+
+
+def main(argv):
+	timeScale = 1.0
+	files = []
+
+	args = iter(argv[1:])
+	for arg in args:
+		if arg == '--time-scale':
+			timeScale = float(next(args))
+		else:
+			files.append(arg)
+
+	if len(files) > 2:
+		print("Invalid argument")
+		return -1
+
+	if len(files) >= 1:
+		with open(files[0], 'rb') as fp:
+			data = fp.read()
+	else:
+		data = getattr(sys.stdin, 'buffer', sys.stdin).read()
+
+	try:
+		trace = convert(parse(data), timeScale)
+	except ValueError as e:
+		print("error: %s" % e)
+		return -1
+
+	if len(files) == 2:
+		with open(files[1], 'w') as fp:
+			json.dump(trace, fp, indent=1)
+	else:
+		json.dump(trace, sys.stdout, indent=1)
+	return 0
+
+
+if __name__ == '__main__':
+	sys.exit(main(sys.argv))
@@ -0,0 +1,390 @@
+#include "Simulator.h"
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+/* Size of the timestamp at the beginning of each message. */
+static const len_t StampSize = (len_t)sizeof(uint32_t);
+
+void SimStatistic::add(double value) {
+  if (Count == 0 || value < Min)
+    Min = value;
+  if (Count == 0 || value > Max)
+    Max = value;
+  Sum += value;
+  ++Count;
+}
+
+Simulator::Simulator(unsigned long seed)
+    : Random(1), CpuBudget(0), CpuUsed(0), TickRate(1000.0), Ticks(0),
+      ScriptTicks(0), Started(false) {
+  setSeed(seed);
+}
+
+Simulator::~Simulator() {
+  for (unsigned i = 0; i < Objects.size(); ++i)
+    delete Objects[i];
+  for (unsigned i = 0; i < Tasks.size(); ++i)
+    delete Tasks[i];
+}
+
+void Simulator::setSeed(unsigned long seed) {
+  /* Xorshift state must not be zero. */
+  Random = (uint32_t)seed ^ 0x9E3779B9UL;
+  if (Random == 0)
+    Random = 1;
+}
+
+/* Uniform random number in (0, 1). Xorshift32, same sequence on every
+ platform. */
+double Simulator::uniform() {
+  Random ^= Random << 13;
+  Random ^= Random >> 17;
+  Random ^= Random << 5;
+  return ((double)Random + 0.5) / 4294967296.0;
+}
+
+int Simulator::addFifo(const std::string &name, len_t length,
+                       len_t messageSize) {
+  if (Started || messageSize < StampSize || length < messageSize)
+    throw std::invalid_argument("invalid fifo " + name);
+
+  SimObject *obj = new SimObject;
+  obj->Type = SIM_FIFO;
+  obj->Length = length;
+  obj->MessageSize = messageSize;
+  obj->Buff.resize((size_t)length);
+  obj->Msg.resize((size_t)messageSize);
+  obj->Report.Name = name;
+  Objects.push_back(obj);
+  return (int)Objects.size() - 1;
+}
+
+int Simulator::addQueue(const std::string &name, len_t length,
+                        len_t messageSize) {
+  if (Started || messageSize < StampSize || length < 1)
+    throw std::invalid_argument("invalid queue " + name);
+
+  SimObject *obj = new SimObject;
+  obj->Type = SIM_QUEUE;
+  obj->Length = length;
+  obj->MessageSize = messageSize;
+  obj->Buff.resize((size_t)length * (size_t)messageSize);
+  obj->Msg.resize((size_t)messageSize);
+  obj->Report.Name = name;
+  Objects.push_back(obj);
+  return (int)Objects.size() - 1;
+}
+
+void Simulator::addPeriodicIsr(int object, tick_t period, tick_t phase) {
+  if (Started || object < 0 || object >= numObjects() || period == 0)
+    throw std::invalid_argument("invalid periodic interrupt");
+
+  SimIsr isr;
+  isr.Type = SIM_PERIODIC;
+  isr.Object = object;
+  isr.Period = period;
+  isr.Phase = phase;
+  isr.Rate = 0.0;
+  isr.NextArrival = 0.0;
+  Isrs.push_back(isr);
+}
+
+void Simulator::addPoissonIsr(int object, double rate) {
+  if (Started || object < 0 || object >= numObjects() || !(rate > 0.0))
+    throw std::invalid_argument("invalid poisson interrupt");
+
+  SimIsr isr;
+  isr.Type = SIM_POISSON;
+  isr.Object = object;
+  isr.Period = 0;
+  isr.Phase = 0;
+  isr.Rate = rate;
+  isr.NextArrival = 0.0;
+  Isrs.push_back(isr);
+}
+
+void Simulator::addTask(int object, priority_t priority, unsigned batch,
+                        unsigned cost, tick_t period) {
+  if (Started || object < 0 || object >= numObjects() || priority < 0 ||
+      priority >= LIBRERTOS_MAX_PRIORITY || batch == 0)
+    throw std::invalid_argument("invalid task");
+
+  for (unsigned i = 0; i < Tasks.size(); ++i)
+    if (Tasks[i]->Priority == priority)
+      throw std::invalid_argument("task priority already used");
+
+  SimTask *task = new SimTask;
+  task->Sim = this;
+  task->Object = object;
+  task->Priority = priority;
+  task->Batch = batch;
+  task->Cost = cost;
+  task->Period = period;
+  Tasks.push_back(task);
+}
+
+const SimObjectReport &Simulator::report(int object) const {
+  return Objects.at((size_t)object)->Report;
+}
+
+len_t Simulator::used(const SimObject &obj) const {
+  if (obj.Type == SIM_FIFO)
+    return (len_t)(Fifo_used(&obj.Fif) / obj.MessageSize);
+  else
+    return Queue_used(&obj.Que);
+}
+
+bool Simulator::canRead(const SimObject &obj) const { return used(obj) > 0; }
+
+bool Simulator::readMessage(SimObject &obj, uint8_t *msg) {
+  if (obj.Type == SIM_FIFO) {
+    /* Messages are written whole, a partial read cannot happen. */
+    if (Fifo_used(&obj.Fif) < obj.MessageSize)
+      return false;
+    return Fifo_read(&obj.Fif, msg, obj.MessageSize) == obj.MessageSize;
+  } else {
+    return Queue_read(&obj.Que, msg) != 0;
+  }
+}
+
+void Simulator::writeMessage(SimObject &obj) {
+  uint8_t *msg = &obj.Msg[0];
+  uint32_t stamp = (uint32_t)Ticks;
+  std::memcpy(msg, &stamp, sizeof(stamp));
+
+  bool ok;
+  if (obj.Type == SIM_FIFO) {
+    /* Drop the message instead of writing part of it. */
+    ok = Fifo_free(&obj.Fif) >= obj.MessageSize &&
+         Fifo_write(&obj.Fif, msg, obj.MessageSize) == obj.MessageSize;
+  } else {
+    ok = Queue_write(&obj.Que, msg) != 0;
+  }
+
+  if (ok)
+    ++obj.Report.Written;
+  else
+    ++obj.Report.Dropped;
+}
+
+void Simulator::pendRead(SimObject &obj) {
+  if (obj.Type == SIM_FIFO)
+    Fifo_pendRead(&obj.Fif, obj.MessageSize, MAX_DELAY);
+  else
+    Queue_pendRead(&obj.Que, MAX_DELAY);
+}
+
+void Simulator::taskFunction(taskParameter_t param) {
+  SimTask *task = (SimTask *)param;
+  task->Sim->consume(*task);
+}
+
+void Simulator::consume(SimTask &task) {
+  SimObject &obj = *Objects[(size_t)task.Object];
+  uint8_t *msg = &obj.Msg[0];
+
+  for (unsigned i = 0; i < task.Batch; ++i) {
+    /* Out of CPU for this tick. */
+    if (CpuBudget != 0 && CpuUsed + task.Cost > CpuBudget)
+      break;
+
+    if (!readMessage(obj, msg))
+      break;
+    CpuUsed += task.Cost;
+
+    uint32_t stamp;
+    std::memcpy(&stamp, msg, sizeof(stamp));
+    ++obj.Report.Read;
+    obj.Report.Latency.add((double)(uint32_t)((uint32_t)Ticks - stamp));
+  }
+
+  if (task.Period != 0)
+    OS_taskDelay(task.Period);
+  else if (canRead(obj))
+    OS_taskDelay(1); /* Batch or CPU exhausted, continue next tick. */
+  else
+    pendRead(obj);
+}
+
+void Simulator::run(unsigned long long ticks) {
+  if (Started)
+    throw std::logic_error("simulation already run");
+  Started = true;
+
+  OS_init();
+
+  for (unsigned i = 0; i < Objects.size(); ++i) {
+    SimObject &obj = *Objects[i];
+    if (obj.Type == SIM_FIFO)
+      Fifo_init(&obj.Fif, &obj.Buff[0], obj.Length);
+    else
+      Queue_init(&obj.Que, &obj.Buff[0], obj.Length, obj.MessageSize);
+  }
+
+  for (unsigned i = 0; i < Tasks.size(); ++i)
+    OS_taskCreate(&Tasks[i]->Task, Tasks[i]->Priority, &taskFunction,
+                  (taskParameter_t)Tasks[i]);
+
+  for (unsigned i = 0; i < Isrs.size(); ++i)
+    if (Isrs[i].Type == SIM_POISSON)
+      Isrs[i].NextArrival = -std::log(uniform()) / Isrs[i].Rate;
+
+  OS_start();
+  OS_scheduler();
+
+  for (unsigned long long t = 0; t < ticks; ++t) {
+    ++Ticks;
+    CpuUsed = 0;
+
+    OS_schedulerLock();
+    OS_tick();
+    OS_schedulerUnlock();
+
+    /* Interrupts of this tick. */
+    for (unsigned i = 0; i < Isrs.size(); ++i) {
+      SimIsr &isr = Isrs[i];
+      SimObject &obj = *Objects[(size_t)isr.Object];
+
+      if (isr.Type == SIM_PERIODIC) {
+        if (Ticks % isr.Period == isr.Phase % isr.Period)
+          writeMessage(obj);
+      } else {
+        while (isr.NextArrival <= (double)Ticks) {
+          writeMessage(obj);
+          isr.NextArrival += -std::log(uniform()) / isr.Rate;
+        }
+      }
+    }
+
+    OS_scheduler();
+
+    for (unsigned i = 0; i < Objects.size(); ++i)
+      Objects[i]->Report.Depth.add((double)used(*Objects[i]));
+  }
+}
+
+bool Simulator::load(std::istream &script, std::string &error) {
+  std::string line;
+  int lineNumber = 0;
+
+  while (std::getline(script, line)) {
+    ++lineNumber;
+
+    std::string::size_type comment = line.find('#');
+    if (comment != std::string::npos)
+      line.erase(comment);
+
+    std::istringstream words(line);
+    std::string cmd;
+    if (!(words >> cmd))
+      continue;
+
+    std::ostringstream where;
+    where << "line " << lineNumber << ": ";
+
+    /* Object index by name. */
+    std::string name;
+    int object = -1;
+    if (cmd == "periodic" || cmd == "poisson" || cmd == "task") {
+      words >> name;
+      for (int i = 0; i < numObjects(); ++i)
+        if (Objects[(size_t)i]->Report.Name == name)
+          object = i;
+      if (object < 0) {
+        error = where.str() + "unknown object '" + name + "'";
+        return false;
+      }
+    }
+
+    try {
+      if (cmd == "seed") {
+        unsigned long seed;
+        if (!(words >> seed))
+          throw std::invalid_argument("expected seed");
+        setSeed(seed);
+      } else if (cmd == "tickrate") {
+        double hz;
+        if (!(words >> hz) || !(hz > 0.0))
+          throw std::invalid_argument("expected tick rate");
+        setTickRate(hz);
+      } else if (cmd == "cpu") {
+        unsigned units;
+        if (!(words >> units))
+          throw std::invalid_argument("expected cpu units");
+        setCpuBudget(units);
+      } else if (cmd == "fifo" || cmd == "queue") {
+        int length, size;
+        if (!(words >> name >> length >> size))
+          throw std::invalid_argument("expected name, length and size");
+        if (length > std::numeric_limits<len_t>::max() ||
+            size > std::numeric_limits<len_t>::max())
+          throw std::invalid_argument("length or size too large");
+        if (cmd == "fifo")
+          addFifo(name, (len_t)length, (len_t)size);
+        else
+          addQueue(name, (len_t)length, (len_t)size);
+      } else if (cmd == "periodic") {
+        unsigned long period, phase = 0;
+        if (!(words >> period))
+          throw std::invalid_argument("expected period");
+        words >> phase;
+        if (period > std::numeric_limits<tick_t>::max() ||
+            phase > std::numeric_limits<tick_t>::max())
+          throw std::invalid_argument("period or phase too large");
+        addPeriodicIsr(object, (tick_t)period, (tick_t)phase);
+      } else if (cmd == "poisson") {
+        double rate;
+        if (!(words >> rate))
+          throw std::invalid_argument("expected rate");
+        addPoissonIsr(object, rate);
+      } else if (cmd == "task") {
+        int priority;
+        unsigned batch, cost = 1;
+        unsigned long period = 0;
+        if (!(words >> priority >> batch))
+          throw std::invalid_argument("expected priority and batch");
+        words >> cost >> period;
+        if (priority < 0 || priority >= LIBRERTOS_MAX_PRIORITY)
+          throw std::invalid_argument("priority out of range");
+        if (period > std::numeric_limits<tick_t>::max())
+          throw std::invalid_argument("period too large");
+        addTask(object, (priority_t)priority, batch, cost, (tick_t)period);
+      } else if (cmd == "run") {
+        if (!(words >> ScriptTicks))
+          throw std::invalid_argument("expected ticks");
+      } else {
+        throw std::invalid_argument("unknown command '" + cmd + "'");
+      }
+    } catch (const std::exception &e) {
+      error = where.str() + e.what();
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void Simulator::printReport(std::FILE *fp) const {
+  double seconds = (double)Ticks / TickRate;
+
+  std::fprintf(fp, "%llu ticks, %.3f s\n", Ticks, seconds);
+  std::fprintf(fp, "%-12s %10s %10s %10s %10s %8s %8s %10s %10s\n", "object",
+               "written", "dropped", "read", "msg/s", "depth", "maxdepth",
+               "latency", "maxlatency");
+
+  for (unsigned i = 0; i < Objects.size(); ++i) {
+    const SimObjectReport &r = Objects[i]->Report;
+    double ms = 1000.0 / TickRate;
+
+    std::fprintf(fp,
+                 "%-12s %10llu %10llu %10llu %10.1f %8.2f %8.0f %8.3fms "
+                 "%8.3fms\n",
+                 r.Name.c_str(), r.Written, r.Dropped, r.Read,
+                 seconds > 0.0 ? (double)r.Read / seconds : 0.0,
+                 r.Depth.mean(), r.Depth.Max, r.Latency.mean() * ms,
+                 r.Latency.Max * ms);
+  }
+}
@@ -0,0 +1,150 @@
+#ifndef SIMULATOR_H_
+#define SIMULATOR_H_
+
+#include "LibreRTOS.h"
+#include <cstdio>
+#include <istream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/* Deterministic virtual time simulation of a LibreRTOS workload.
+
+ The simulator drives OS_tick() and OS_scheduler() tick by tick. Interrupts
+ write messages into Fifo_t and Queue_t objects at periodic or Poisson
+ distributed arrivals, and consumer tasks read them. Each message carries the
+ tick it was written, so the consumers measure the latency. Results are
+ repeatable for the same workload and seed.
+
+ The kernel state is global, only one simulation runs at a time. */
+
+/* Running statistic of a sampled value. */
+struct SimStatistic {
+  unsigned long long Count;
+  double Sum;
+  double Min;
+  double Max;
+
+  SimStatistic() : Count(0), Sum(0.0), Min(0.0), Max(0.0) {}
+
+  void add(double value);
+  double mean() const { return Count != 0 ? Sum / (double)Count : 0.0; }
+};
+
+/* Results of one kernel object. */
+struct SimObjectReport {
+  std::string Name;
+  unsigned long long Written;
+  unsigned long long Dropped;
+  unsigned long long Read;
+  SimStatistic Depth;   /* Messages in the object, sampled every tick. */
+  SimStatistic Latency; /* Ticks from the interrupt write to the task read. */
+
+  SimObjectReport() : Written(0), Dropped(0), Read(0) {}
+};
+
+class Simulator {
+public:
+  explicit Simulator(unsigned long seed = 1);
+  ~Simulator();
+
+  /* Kernel objects, return the object index. Messages carry a 32-bit
+   timestamp, messageSize must be at least 4 bytes. */
+  int addFifo(const std::string &name, len_t length, len_t messageSize);
+  int addQueue(const std::string &name, len_t length, len_t messageSize);
+
+  /* Interrupt writing one message every period ticks. */
+  void addPeriodicIsr(int object, tick_t period, tick_t phase = 0);
+  /* Interrupt writing messages at a mean rate per tick. */
+  void addPoissonIsr(int object, double rate);
+
+  /* Task reading up to batch messages of the object per activation, each one
+   costing cost CPU units. A task with a period delays between activations,
+   otherwise it pends on the object. */
+  void addTask(int object, priority_t priority, unsigned batch,
+               unsigned cost = 1, tick_t period = 0);
+
+  /* CPU units available per tick, shared by the tasks in priority order.
+   Zero is unlimited. */
+  void setCpuBudget(unsigned units) { CpuBudget = units; }
+
+  /* Restart the random number generator. */
+  void setSeed(unsigned long seed);
+
+  /* Ticks per second, used only to report times. */
+  void setTickRate(double hz) { TickRate = hz; }
+
+  /* Load a workload script. Return false and set error on failure. */
+  bool load(std::istream &script, std::string &error);
+
+  /* Run the simulation. Can be called only once. */
+  void run(unsigned long long ticks);
+
+  unsigned long long ticks() const { return Ticks; }
+  unsigned long long scriptedTicks() const { return ScriptTicks; }
+  const SimObjectReport &report(int object) const;
+  int numObjects() const { return (int)Objects.size(); }
+  void printReport(std::FILE *fp) const;
+
+private:
+  enum ObjectType { SIM_FIFO, SIM_QUEUE };
+  enum IsrType { SIM_PERIODIC, SIM_POISSON };
+
+  struct SimObject {
+    ObjectType Type;
+    len_t Length;
+    len_t MessageSize;
+    std::vector<uint8_t> Buff;
+    std::vector<uint8_t> Msg; /* One message, reused by ISRs and tasks. */
+    struct Fifo_t Fif;
+    struct Queue_t Que;
+    SimObjectReport Report;
+  };
+
+  struct SimIsr {
+    IsrType Type;
+    int Object;
+    tick_t Period;
+    tick_t Phase;
+    double Rate;
+    double NextArrival;
+  };
+
+  struct SimTask {
+    Simulator *Sim;
+    struct task_t Task;
+    int Object;
+    priority_t Priority;
+    unsigned Batch;
+    unsigned Cost;
+    tick_t Period;
+  };
+
+  static void taskFunction(taskParameter_t param);
+  void consume(SimTask &task);
+
+  bool canRead(const SimObject &obj) const;
+  bool readMessage(SimObject &obj, uint8_t *msg);
+  void writeMessage(SimObject &obj);
+  void pendRead(SimObject &obj);
+  len_t used(const SimObject &obj) const;
+  double uniform();
+
+  std::vector<SimObject *> Objects;
+  std::vector<SimIsr> Isrs;
+  std::vector<SimTask *> Tasks;
+
+  uint32_t Random;
+  unsigned CpuBudget;
+  unsigned CpuUsed;
+  double TickRate;
+  unsigned long long Ticks;
+  unsigned long long ScriptTicks;
+  bool Started;
+
+  /* Non copyable, kernel holds pointers to the objects. */
+  Simulator(const Simulator &);
+  Simulator &operator=(const Simulator &);
+};
+
+#endif /* SIMULATOR_H_ */
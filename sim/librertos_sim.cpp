@@ -0,0 +1,34 @@
+#include "Simulator.h"
+#include <fstream>
+#include <iostream>
+
+/* Run a workload script and print the report.
+ Usage: librertos_sim WORKLOAD [TICKS] */
+int main(int argc, char **argv) {
+  if (argc < 2 || argc > 3) {
+    std::cerr << "Usage: " << argv[0] << " WORKLOAD [TICKS]" << std::endl;
+    return 1;
+  }
+
+  std::ifstream script(argv[1]);
+  if (!script) {
+    std::cerr << argv[1] << ": error: Could not open file" << std::endl;
+    return 1;
+  }
+
+  Simulator sim;
+  std::string error;
+  if (!sim.load(script, error)) {
+    std::cerr << argv[1] << ": error: " << error << std::endl;
+    return 1;
+  }
+
+  unsigned long long ticks = sim.scriptedTicks();
+  if (argc == 3)
+    ticks = std::stoull(argv[2]);
+
+  sim.run(ticks);
+  sim.printReport(stdout);
+
+  return 0;
+}
@@ -1,3 +1,57 @@
 #include "LibreRTOS.h"
+#include "OSlist.h"
 
 inline void setCurrentTask(struct task_t *task) { OSstate.CurrentTCB = task; }
+
+/* Advance the system run time, simulating a task that takes some time. */
+void librertos_test_add_run_time(stattime_t time);
+
+/* Function called by the idle hook, NULL to do nothing. */
+void librertos_test_set_idle_behavior(void (*f)(tick_t ticks));
+
+/* List of tasks delayed without overflowing the tick count. With 64-bit ticks
+ the tick count never overflows and there is a single blocked task list. */
+inline struct taskHeadList_t *blockedTaskList() {
+#if (LIBRERTOS_TICK_BITS != 64)
+  return OSstate.BlockedTaskList_NotOverflowed;
+#else
+  return &OSstate.BlockedTaskList1;
+#endif
+}
+
+/* Nodes as given to the list functions and stored in the list links, and the
+ end of a list. Compact lists link nodes by index and end with LIST_END. */
+#if (LIBRERTOS_COMPACT_LISTS == 0)
+inline struct taskListNode_t *eventNode(struct task_t *task) {
+  return &task->NodeEvent;
+}
+
+inline struct taskListNode_t *listEnd(struct taskHeadList_t *list) {
+  return (struct taskListNode_t *)list;
+}
+
+#if (LIBRERTOS_SOFTWARETIMERS != 0)
+inline struct taskListNode_t *timerNode(struct Timer_t *timer) {
+  return &timer->NodeTimer;
+}
+#endif
+#else
+inline listIndex_t eventNode(struct task_t *task) {
+  return LIST_INDEX_EVENT(task->Priority);
+}
+
+inline listIndex_t listEnd(struct taskHeadList_t *list) {
+  (void)list;
+  return LIST_END;
+}
+
+#if (LIBRERTOS_SOFTWARETIMERS != 0)
+/* Timers are addressed by their slot in the timer table. */
+inline listIndex_t timerNode(struct Timer_t *timer) {
+  for (int i = 0; i < LIBRERTOS_MAX_TIMERS; ++i)
+    if (OSstate.Timer[i] == timer)
+      return LIST_INDEX_TIMER(i);
+  return LIST_END;
+}
+#endif
+#endif
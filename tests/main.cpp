@@ -22,7 +22,28 @@ void librertos_test_concurrent_access(void) {
     func();
 }
 
+/* SYSTEM RUN TIME */
+
+/* Atomic, the threads tests run one scheduler per thread. */
+static stattime_t runTime = 0;
+
+void librertos_test_add_run_time(stattime_t time) {
+  __sync_add_and_fetch(&runTime, time);
+}
+
 extern "C" stattime_t US_systemRunTime(void) {
-  static stattime_t i = 0;
-  return ++i;
+  return __sync_add_and_fetch(&runTime, 1);
+}
+
+/* IDLE HOOK */
+
+static void (*idleFunc)(tick_t ticks) = (void (*)(tick_t))0;
+
+void librertos_test_set_idle_behavior(void (*f)(tick_t ticks)) {
+  idleFunc = f;
+}
+
+extern "C" void US_idleHook(tick_t ticks) {
+  if (idleFunc != (void (*)(tick_t))0)
+    idleFunc(ticks);
 }
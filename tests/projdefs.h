@@ -25,23 +25,106 @@ extern "C" {
 #include <stdint.h>
 
 /* LibreRTOS definitions. */
+#ifndef LIBRERTOS_TICK_BITS
+#define LIBRERTOS_TICK_BITS 16     /* 16, 32 or 64 */
+#endif
 #define LIBRERTOS_MAX_PRIORITY 10  /* integer > 0 */
+#ifndef LIBRERTOS_PREEMPTION
 #define LIBRERTOS_PREEMPTION 0     /* boolean */
+#endif
 #define LIBRERTOS_PREEMPT_LIMIT 0  /* integer >= 0, < LIBRERTOS_MAX_PRIORITY */
+#ifndef LIBRERTOS_SOFTWARETIMERS
 #define LIBRERTOS_SOFTWARETIMERS 1 /* boolean */
+#endif
+#ifndef LIBRERTOS_STATE_GUARDS
 #define LIBRERTOS_STATE_GUARDS 0   /* boolean */
+#endif
+#ifndef LIBRERTOS_STATISTICS
 #define LIBRERTOS_STATISTICS 0     /* boolean */
+#endif
+#ifndef LIBRERTOS_TIMER_MERGE_QUOTA
+#define LIBRERTOS_TIMER_MERGE_QUOTA 2 /* integer >= 0, 0 = unbounded */
+#endif
+#ifndef LIBRERTOS_TRACE
+#define LIBRERTOS_TRACE 0          /* boolean */
+#endif
+#ifndef LIBRERTOS_TRACE_LENGTH
+#define LIBRERTOS_TRACE_LENGTH 32  /* integer power of 2 */
+#endif
+#ifndef LIBRERTOS_COMPACT_LISTS
+#define LIBRERTOS_COMPACT_LISTS 0  /* 0 (pointers), 8 or 16 (index bits) */
+#endif
+#ifndef LIBRERTOS_MAX_TIMERS
+#define LIBRERTOS_MAX_TIMERS 16    /* integer > 0, with compact lists */
+#endif
+#ifndef LIBRERTOS_HEAP
+#define LIBRERTOS_HEAP 1           /* boolean */
+#endif
+#ifndef LIBRERTOS_DEFER_LENGTH
+#define LIBRERTOS_DEFER_LENGTH 8   /* integer power of 2, 0 = disabled */
+#endif
+#ifndef LIBRERTOS_PROFILE_CRITICAL
+#define LIBRERTOS_PROFILE_CRITICAL 0 /* boolean */
+#endif
+#define LIBRERTOS_PROFILE_SITES 32 /* integer > 0 */
+#define LIBRERTOS_PROFILE_BINS 8   /* integer > 1 */
+#ifndef LIBRERTOS_NOTIFICATIONS
+#define LIBRERTOS_NOTIFICATIONS 0  /* boolean */
+#endif
+#ifndef LIBRERTOS_MULTIPLE_INSTANCES
+#define LIBRERTOS_MULTIPLE_INSTANCES 0 /* boolean */
+#endif
+#ifndef LIBRERTOS_WORK_STEALING
+#define LIBRERTOS_WORK_STEALING 0 /* boolean, with multiple instances */
+#endif
+#define LIBRERTOS_MAX_INSTANCES 4      /* integer > 0, with work stealing */
+#define LIBRERTOS_WORK_DEQUE_LENGTH 64 /* integer power of 2 */
+#ifndef LIBRERTOS_QUEUE_LOCKFREE
+#define LIBRERTOS_QUEUE_LOCKFREE 0 /* boolean */
+#endif
+#ifndef LIBRERTOS_CACHE_LINE_SIZE
+#define LIBRERTOS_CACHE_LINE_SIZE 0 /* integer power of 2, 0 = compact */
+#endif
+#ifndef LIBRERTOS_IDLE_HOOK
+#define LIBRERTOS_IDLE_HOOK 0 /* boolean */
+#endif
+#ifndef LIBRERTOS_EDF
+#define LIBRERTOS_EDF 0 /* boolean */
+#endif
 
 typedef int8_t priority_t;
 typedef uint8_t schedulerLock_t;
+#if (LIBRERTOS_TICK_BITS == 64)
+typedef uint64_t tick_t;
+typedef int64_t difftick_t;
+#elif (LIBRERTOS_TICK_BITS == 32)
+typedef uint32_t tick_t;
+typedef int32_t difftick_t;
+#else
 typedef uint16_t tick_t;
 typedef int16_t difftick_t;
+#endif
 typedef uint32_t stattime_t;
+typedef uint32_t statcount_t;
 typedef int16_t len_t;
 typedef uint8_t bool_t;
+typedef uint32_t notify_t;
 
 #define MAX_DELAY ((tick_t)-1)
 
+/* Storage of the selected kernel instance, one per thread. */
+#define LIBRERTOS_THREAD_LOCAL __thread
+
+/* Memory barrier for lock-free data shared between threads. */
+#define MEMORY_BARRIER() __sync_synchronize()
+
+/* Atomic compare and swap, evaluates to 1 if *ptr was old and is now new. */
+#define COMPARE_AND_SWAP(ptr, old, new)                                        \
+  __sync_bool_compare_and_swap(ptr, old, new)
+
+/* Alignment of a variable or structure member to n bytes. */
+#define ALIGNED(n) __attribute__((aligned(n)))
+
 /* Assert macro. */
 void myassert(int x);
 #define ASSERT(x) myassert(x)
@@ -60,14 +143,30 @@ void myassert(int x);
 
 /* Nested critical section management macros. */
 #define CRITICAL_VAL() int _cpu_state = 0
+#if (LIBRERTOS_PROFILE_CRITICAL != 0)
+/* Record hold time of the outermost critical section per call site. */
+void OS_profileCriticalEnter(const char *file, int line);
+void OS_profileCriticalExit(void);
 #define CRITICAL_ENTER()                                                       \
   do {                                                                         \
     ++_cpu_state;                                                              \
+    OS_profileCriticalEnter(__FILE__, __LINE__);                               \
   } while (0)
 #define CRITICAL_EXIT()                                                        \
   do {                                                                         \
+    OS_profileCriticalExit();                                                  \
     --_cpu_state;                                                              \
   } while (0)
+#else
+#define CRITICAL_ENTER()                                                       \
+  do {                                                                         \
+    ++_cpu_state;                                                              \
+  } while (0)
+#define CRITICAL_EXIT()                                                        \
+  do {                                                                         \
+    --_cpu_state;                                                              \
+  } while (0)
+#endif
 
 /* Simulate concurrent access. For test coverage only. */
 void librertos_test_set_concurrent_behavior(void (*f)(void));
@@ -0,0 +1,126 @@
+#include "LibreRTOS.h"
+#include <boost/test/unit_test.hpp>
+#include <cstddef>
+
+/* The padded layout is built with:
+ scripts/run_config_tests.sh "-DLIBRERTOS_CACHE_LINE_SIZE=64" \
+     tests/test_CacheLine.cpp */
+
+#if (LIBRERTOS_CACHE_LINE_SIZE != 0)
+
+static const size_t Line = LIBRERTOS_CACHE_LINE_SIZE;
+
+/* Cache line of the member, relative to the start of the structure. */
+#define LINE_OF(type, member) (offsetof(type, member) / Line)
+
+BOOST_AUTO_TEST_SUITE(CacheLine)
+
+BOOST_AUTO_TEST_CASE(fifo) {
+  BOOST_CHECK_EQUAL(alignof(struct Fifo_t), Line);
+
+  /* Consumer side. */
+  BOOST_CHECK_EQUAL(LINE_OF(Fifo_t, Used), LINE_OF(Fifo_t, Head));
+  BOOST_CHECK_EQUAL(LINE_OF(Fifo_t, RLock), LINE_OF(Fifo_t, Head));
+
+  /* Producer side. */
+  BOOST_CHECK_EQUAL(LINE_OF(Fifo_t, Free), LINE_OF(Fifo_t, Tail));
+  BOOST_CHECK_EQUAL(LINE_OF(Fifo_t, WLock), LINE_OF(Fifo_t, Tail));
+
+  BOOST_CHECK_NE(LINE_OF(Fifo_t, Head), LINE_OF(Fifo_t, Tail));
+  BOOST_CHECK_NE(LINE_OF(Fifo_t, Event), LINE_OF(Fifo_t, Head));
+  BOOST_CHECK_NE(LINE_OF(Fifo_t, Event), LINE_OF(Fifo_t, Tail));
+}
+
+BOOST_AUTO_TEST_CASE(queue) {
+  BOOST_CHECK_EQUAL(alignof(struct Queue_t), Line);
+
+  BOOST_CHECK_EQUAL(LINE_OF(Queue_t, Used), LINE_OF(Queue_t, Head));
+  BOOST_CHECK_EQUAL(LINE_OF(Queue_t, RLock), LINE_OF(Queue_t, Head));
+
+  BOOST_CHECK_EQUAL(LINE_OF(Queue_t, Free), LINE_OF(Queue_t, Tail));
+  BOOST_CHECK_EQUAL(LINE_OF(Queue_t, WLock), LINE_OF(Queue_t, Tail));
+
+  BOOST_CHECK_NE(LINE_OF(Queue_t, Head), LINE_OF(Queue_t, Tail));
+  BOOST_CHECK_NE(LINE_OF(Queue_t, Event), LINE_OF(Queue_t, Head));
+  BOOST_CHECK_NE(LINE_OF(Queue_t, Event), LINE_OF(Queue_t, Tail));
+
+#if (LIBRERTOS_QUEUE_LOCKFREE != 0)
+  BOOST_CHECK_EQUAL(LINE_OF(Queue_t, ReadPos), LINE_OF(Queue_t, Head));
+  BOOST_CHECK_EQUAL(LINE_OF(Queue_t, WritePos), LINE_OF(Queue_t, Tail));
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(os_state) {
+  typedef struct libreRtosState_t State;
+
+  BOOST_CHECK_EQUAL(alignof(State), Line);
+
+  /* Written by the tick. */
+  BOOST_CHECK_EQUAL(LINE_OF(State, DelayedTicks), LINE_OF(State, Tick));
+
+  /* Written by the scheduler. */
+  BOOST_CHECK_EQUAL(LINE_OF(State, SchedulerLock), LINE_OF(State, CurrentTCB));
+
+  /* Read by the scheduler, written only when tasks are created. */
+  BOOST_CHECK_NE(LINE_OF(State, Task), LINE_OF(State, Tick));
+  BOOST_CHECK_NE(LINE_OF(State, Task), LINE_OF(State, CurrentTCB));
+  BOOST_CHECK_NE(LINE_OF(State, Tick), LINE_OF(State, CurrentTCB));
+}
+
+BOOST_AUTO_TEST_CASE(adjacent_objects) {
+  struct Fifo_t fifos[2];
+  struct Queue_t queues[2];
+
+  /* Neighbouring objects never share a line. */
+  BOOST_CHECK_EQUAL(sizeof(struct Fifo_t) % Line, 0);
+  BOOST_CHECK_EQUAL(sizeof(struct Queue_t) % Line, 0);
+  BOOST_CHECK_EQUAL(sizeof(struct libreRtosState_t) % Line, 0);
+
+  BOOST_CHECK_EQUAL((size_t)&fifos[0] % Line, 0);
+  BOOST_CHECK_EQUAL((size_t)&queues[1] % Line, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#else
+
+/* Padding between the end of member prev and the start of member next. With
+ the compact layout it is only what the alignment of next requires. */
+#define GAP(type, prev, next)                                                  \
+  (offsetof(type, next) - offsetof(type, prev) - sizeof(((type *)0)->prev))
+#define MEMBER_ALIGN(type, member) alignof(decltype(((type *)0)->member))
+
+/* Padding after the last member, only up to the alignment of the type. */
+#define TAIL(type, last)                                                       \
+  (sizeof(type) - offsetof(type, last) - sizeof(((type *)0)->last))
+
+BOOST_AUTO_TEST_SUITE(CacheLine)
+
+BOOST_AUTO_TEST_CASE(compact_layout) {
+  /* The members aligned to a line in the padded layout are packed after the
+   member before them, and the objects end after their last member. */
+  BOOST_CHECK_LT(GAP(Fifo_t, Event, Head), MEMBER_ALIGN(Fifo_t, Head));
+  BOOST_CHECK_LT(GAP(Fifo_t, RLock, Tail), MEMBER_ALIGN(Fifo_t, Tail));
+  BOOST_CHECK_LT(TAIL(Fifo_t, WLock), alignof(struct Fifo_t));
+
+#if (LIBRERTOS_QUEUE_LOCKFREE != 0)
+  BOOST_CHECK_LT(GAP(Queue_t, LockFree, Head), MEMBER_ALIGN(Queue_t, Head));
+  BOOST_CHECK_LT(GAP(Queue_t, ReadPos, Tail), MEMBER_ALIGN(Queue_t, Tail));
+  BOOST_CHECK_LT(TAIL(Queue_t, WritePos), alignof(struct Queue_t));
+#else
+  BOOST_CHECK_LT(GAP(Queue_t, Event, Head), MEMBER_ALIGN(Queue_t, Head));
+  BOOST_CHECK_LT(GAP(Queue_t, RLock, Tail), MEMBER_ALIGN(Queue_t, Tail));
+  BOOST_CHECK_LT(TAIL(Queue_t, WLock), alignof(struct Queue_t));
+#endif
+
+  typedef struct libreRtosState_t State;
+
+  BOOST_CHECK_EQUAL(offsetof(State, Task), 0);
+  BOOST_CHECK_LT(GAP(State, Task, CurrentTCB), MEMBER_ALIGN(State, CurrentTCB));
+  BOOST_CHECK_LT(GAP(State, SchedulerUnlockTodo, Tick),
+                 MEMBER_ALIGN(State, Tick));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif /* LIBRERTOS_CACHE_LINE_SIZE */
@@ -0,0 +1,239 @@
+#include "LibreRTOS.h"
+#include "TheHeader.h"
+#include <boost/test/unit_test.hpp>
+
+struct CondVarFixture {
+  static const int NumTasks = 3;
+
+  struct CondVar_t Cv;
+  struct Mutex_t Mtx;
+  struct task_t Task[NumTasks];
+
+  CondVarFixture() {
+    OS_init();
+    OS_start();
+
+    CondVar_init(&Cv);
+    Mutex_init(&Mtx);
+
+    for (int i = 0; i < NumTasks; ++i)
+      OS_taskCreate(&Task[i], (priority_t)i, NULL, NULL);
+  }
+  ~CondVarFixture() { BOOST_CHECK_EQUAL(OSstate.SchedulerLock, 0); }
+
+  /* Lock the mutex and wait on the condition variable. */
+  void lockAndWait(struct task_t *task, tick_t ticks) {
+    setCurrentTask(task);
+    BOOST_REQUIRE_EQUAL(Mutex_lock(&Mtx), 1);
+    CondVar_wait(&Cv, &Mtx, ticks);
+    setCurrentTask(NULL);
+  }
+
+  void checkUnblocked(struct task_t *task) {
+    BOOST_CHECK_EQUAL(task->NodeEvent.List, (void *)0);
+    BOOST_CHECK_EQUAL(task->NodeDelay.List, (void *)0);
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(CondVar, CondVarFixture)
+
+BOOST_AUTO_TEST_CASE(init) {
+  BOOST_CHECK_EQUAL(Cv.Mutex, (void *)0);
+
+#if (LIBRERTOS_COMPACT_LISTS == 0)
+  const struct taskListNode_t *nodeHead =
+      (struct taskListNode_t *)&Cv.Event.ListRead;
+  BOOST_CHECK_EQUAL(Cv.Event.ListRead.Head, nodeHead);
+  BOOST_CHECK_EQUAL(Cv.Event.ListRead.Tail, nodeHead);
+#endif
+  BOOST_CHECK_EQUAL(Cv.Event.ListRead.Length, 0);
+}
+
+BOOST_AUTO_TEST_CASE(wait_0_tick) {
+  lockAndWait(&Task[0], 0);
+
+  /* Mutex released, nothing to wait. */
+  BOOST_CHECK_EQUAL(Mutex_getCount(&Mtx), 0);
+  BOOST_CHECK_EQUAL(Mutex_getOwner(&Mtx), (void *)0);
+
+  checkUnblocked(&Task[0]);
+  BOOST_CHECK_EQUAL(Cv.Event.ListRead.Length, 0);
+}
+
+BOOST_AUTO_TEST_CASE(wait_1_tick) {
+  lockAndWait(&Task[0], 1);
+
+  BOOST_CHECK_EQUAL(Mutex_getCount(&Mtx), 0);
+  BOOST_CHECK_EQUAL(Mutex_getOwner(&Mtx), (void *)0);
+  BOOST_CHECK_EQUAL(Cv.Mutex, &Mtx);
+
+  BOOST_CHECK_EQUAL(Task[0].NodeEvent.List, &Cv.Event.ListRead);
+  BOOST_CHECK_EQUAL(Task[0].NodeDelay.List, &OSstate.BlockedTaskList1);
+  BOOST_CHECK_EQUAL(Cv.Event.ListRead.Length, 1);
+}
+
+BOOST_AUTO_TEST_CASE(wait_unblocks_mutex_waiter) {
+  setCurrentTask(&Task[0]);
+  Mutex_lock(&Mtx);
+
+  setCurrentTask(&Task[1]);
+  Mutex_pend(&Mtx, MAX_DELAY);
+
+  setCurrentTask(&Task[0]);
+  CondVar_wait(&Cv, &Mtx, MAX_DELAY);
+
+  /* Releasing the mutex is the same as Mutex_unlock(). */
+  checkUnblocked(&Task[1]);
+  BOOST_CHECK_EQUAL(Mtx.Event.ListRead.Length, 0);
+  BOOST_CHECK_EQUAL(Task[0].NodeEvent.List, &Cv.Event.ListRead);
+}
+
+BOOST_AUTO_TEST_CASE(wait_mutex_not_owned) {
+  setCurrentTask(&Task[0]);
+  BOOST_CHECK_THROW(CondVar_wait(&Cv, &Mtx, 1), int);
+
+  setCurrentTask(&Task[1]);
+  Mutex_lock(&Mtx);
+
+  setCurrentTask(&Task[0]);
+  BOOST_CHECK_THROW(CondVar_wait(&Cv, &Mtx, 1), int);
+
+  BOOST_CHECK_EQUAL(Mutex_getOwner(&Mtx), &Task[1]);
+  BOOST_CHECK_EQUAL(Cv.Event.ListRead.Length, 0);
+}
+
+BOOST_AUTO_TEST_CASE(wait_mutex_locked_recursively) {
+  setCurrentTask(&Task[0]);
+  Mutex_lock(&Mtx);
+  Mutex_lock(&Mtx);
+
+  /* The task could not lock it back to the same count. */
+  BOOST_CHECK_THROW(CondVar_wait(&Cv, &Mtx, 1), int);
+
+  BOOST_CHECK_EQUAL(Mutex_getCount(&Mtx), 2);
+}
+
+BOOST_AUTO_TEST_CASE(wait_different_mutex) {
+  struct Mutex_t mtx2;
+
+  Mutex_init(&mtx2);
+  lockAndWait(&Task[0], MAX_DELAY);
+
+  /* All waiters use the same mutex. */
+  setCurrentTask(&Task[1]);
+  Mutex_lock(&mtx2);
+  BOOST_CHECK_THROW(CondVar_wait(&Cv, &mtx2, 1), int);
+
+  BOOST_CHECK_EQUAL(Mutex_getOwner(&mtx2), &Task[1]);
+  BOOST_CHECK_EQUAL(Cv.Event.ListRead.Length, 1);
+}
+
+BOOST_AUTO_TEST_CASE(signal_no_waiter) {
+  CondVar_signal(&Cv);
+  CondVar_broadcast(&Cv);
+
+  BOOST_CHECK_EQUAL(Cv.Event.ListRead.Length, 0);
+}
+
+BOOST_AUTO_TEST_CASE(signal_unblocks_one_task) {
+  lockAndWait(&Task[0], MAX_DELAY);
+  lockAndWait(&Task[1], MAX_DELAY);
+
+  CondVar_signal(&Cv);
+
+  /* Highest priority first. */
+  checkUnblocked(&Task[1]);
+  BOOST_CHECK_EQUAL(Task[0].NodeEvent.List, &Cv.Event.ListRead);
+  BOOST_CHECK_EQUAL(Cv.Event.ListRead.Length, 1);
+
+  CondVar_signal(&Cv);
+
+  checkUnblocked(&Task[0]);
+  BOOST_CHECK_EQUAL(Cv.Event.ListRead.Length, 0);
+}
+
+BOOST_AUTO_TEST_CASE(signal_mutex_locked) {
+  lockAndWait(&Task[0], 10);
+
+  setCurrentTask(&Task[2]);
+  Mutex_lock(&Mtx);
+  CondVar_signal(&Cv);
+
+  /* Moved to the mutex, it would fail to lock it if unblocked now. The
+   timeout still applies. */
+  BOOST_CHECK_EQUAL(Task[0].NodeEvent.List, &Mtx.Event.ListRead);
+  BOOST_CHECK_EQUAL(Task[0].NodeDelay.List, &OSstate.BlockedTaskList1);
+  BOOST_CHECK_EQUAL(Cv.Event.ListRead.Length, 0);
+  BOOST_CHECK_EQUAL(Mtx.Event.ListRead.Length, 1);
+
+  Mutex_unlock(&Mtx);
+
+  checkUnblocked(&Task[0]);
+  BOOST_CHECK_EQUAL(Mtx.Event.ListRead.Length, 0);
+
+  setCurrentTask(&Task[0]);
+  BOOST_CHECK_EQUAL(Mutex_lock(&Mtx), 1);
+}
+
+BOOST_AUTO_TEST_CASE(broadcast_unblocks_all_tasks) {
+  lockAndWait(&Task[0], MAX_DELAY);
+  lockAndWait(&Task[1], MAX_DELAY);
+
+  CondVar_broadcast(&Cv);
+
+  checkUnblocked(&Task[0]);
+  checkUnblocked(&Task[1]);
+  BOOST_CHECK_EQUAL(Cv.Event.ListRead.Length, 0);
+}
+
+BOOST_AUTO_TEST_CASE(broadcast_mutex_locked) {
+  lockAndWait(&Task[0], MAX_DELAY);
+  lockAndWait(&Task[1], MAX_DELAY);
+
+  setCurrentTask(&Task[2]);
+  Mutex_lock(&Mtx);
+  CondVar_broadcast(&Cv);
+
+  BOOST_CHECK_EQUAL(Cv.Event.ListRead.Length, 0);
+  BOOST_CHECK_EQUAL(Mtx.Event.ListRead.Length, 2);
+
+  /* Woken one at a time by the mutex, not all to contend for it. */
+  Mutex_unlock(&Mtx);
+
+  checkUnblocked(&Task[1]);
+  BOOST_CHECK_EQUAL(Task[0].NodeEvent.List, &Mtx.Event.ListRead);
+
+  setCurrentTask(&Task[1]);
+  Mutex_lock(&Mtx);
+  Mutex_unlock(&Mtx);
+
+  checkUnblocked(&Task[0]);
+}
+
+BOOST_AUTO_TEST_CASE(wait_timeout) {
+  lockAndWait(&Task[0], 1);
+
+  OS_tick();
+  OS_schedulerLock();
+  OS_schedulerUnlock();
+
+  checkUnblocked(&Task[0]);
+  BOOST_CHECK_EQUAL(Cv.Event.ListRead.Length, 0);
+
+  /* A later signal finds no waiter. */
+  CondVar_signal(&Cv);
+  BOOST_CHECK_EQUAL(Mtx.Event.ListRead.Length, 0);
+}
+
+BOOST_AUTO_TEST_CASE(wait_again_after_wake) {
+  lockAndWait(&Task[0], MAX_DELAY);
+  CondVar_signal(&Cv);
+
+  /* Task runs again, re-locks the mutex and checks the predicate. */
+  lockAndWait(&Task[0], MAX_DELAY);
+
+  BOOST_CHECK_EQUAL(Task[0].NodeEvent.List, &Cv.Event.ListRead);
+  BOOST_CHECK_EQUAL(Mutex_getOwner(&Mtx), (void *)0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,291 @@
+#include "Coroutine.h"
+#include "LibreRTOS.h"
+#include "TheHeader.h"
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+#if (__cplusplus >= 202002L)
+
+/* Built with C++20 only:
+ CXXSTD=c++20 scripts/run_config_tests.sh "" tests/test_Coroutine.cpp */
+
+typedef uint32_t QueType;
+
+static std::vector<long> Log;
+
+struct CoroutineFixture {
+  static const int Len = 4;
+
+  struct Semaphore_t Sem;
+  struct Mutex_t Mtx;
+  struct Queue_t Que;
+  QueType QueBuff[Len];
+  struct Fifo_t Fif;
+  uint8_t FifBuff[8];
+
+  CoroutineTask CoTask;
+
+  CoroutineFixture() {
+    Log.clear();
+
+    OS_init();
+
+    Semaphore_init(&Sem, 0, 1);
+    Mutex_init(&Mtx);
+    Queue_init(&Que, &QueBuff[0], Len, (len_t)sizeof(QueType));
+    Fifo_init(&Fif, &FifBuff[0], (len_t)sizeof(FifBuff));
+
+    OS_start();
+  }
+  ~CoroutineFixture() { BOOST_CHECK_EQUAL(OSstate.SchedulerLock, 0); }
+
+  void tickAndSchedule(tick_t ticks) {
+    for (tick_t i = 0; i < ticks; ++i) {
+      OS_tick();
+      OS_scheduler();
+    }
+  }
+};
+
+static Coroutine takeTwice(struct Semaphore_t *sem) {
+  Log.push_back(1);
+  co_await coSemaphoreTake(sem);
+  Log.push_back(2);
+  co_await coSemaphoreTake(sem);
+  Log.push_back(3);
+}
+
+static Coroutine takeLoop(struct Semaphore_t *sem, tick_t ticks) {
+  for (;;)
+    Log.push_back(co_await coSemaphoreTake(sem, ticks));
+}
+
+static Coroutine readLoop(struct Queue_t *que) {
+  for (;;) {
+    QueType x = 0;
+    co_await coQueueRead(que, &x);
+    Log.push_back((long)x);
+  }
+}
+
+static Coroutine fifoReadOnce(struct Fifo_t *fif) {
+  uint8_t buff[4];
+  len_t n = co_await coFifoRead(fif, &buff[0], (len_t)sizeof(buff));
+  Log.push_back(n);
+  for (len_t i = 0; i < n; ++i)
+    Log.push_back(buff[i]);
+}
+
+static Coroutine lockOnce(struct Mutex_t *mtx) {
+  Log.push_back(co_await coMutexLock(mtx));
+  Mutex_unlock(mtx);
+}
+
+static Coroutine delayTwice(void) {
+  co_await coDelay(3);
+  Log.push_back(OS_getTickCount());
+  co_await coDelay(0);
+  co_await coDelay(2);
+  Log.push_back(OS_getTickCount());
+}
+
+static Coroutine delayUntilLoop(void) {
+  tick_t lastWake = OS_getTickCount();
+  for (;;) {
+    co_await coDelayUntil(&lastWake, 5);
+    Log.push_back(OS_getTickCount());
+  }
+}
+
+static Coroutine returnAtOnce(void) {
+  Log.push_back(1);
+  co_return;
+}
+
+BOOST_FIXTURE_TEST_SUITE(CoroutineTasks, CoroutineFixture)
+
+BOOST_AUTO_TEST_CASE(run_until_await) {
+  CoTask.create(0, takeTwice(&Sem));
+
+  /* Body starts on the first activation. */
+  BOOST_CHECK_EQUAL(Log.size(), 0);
+
+  OS_scheduler();
+
+  BOOST_CHECK_EQUAL(Log.size(), 1);
+  BOOST_CHECK_EQUAL(CoTask.Task.State, TASKSTATE_BLOCKED);
+  BOOST_CHECK_EQUAL(CoTask.Task.NodeEvent.List, &Sem.Event.ListRead);
+}
+
+BOOST_AUTO_TEST_CASE(resume_at_await) {
+  CoTask.create(0, takeTwice(&Sem));
+  OS_scheduler();
+
+  Semaphore_give(&Sem);
+  OS_scheduler();
+
+  /* Resumed after the first await, not from the start. */
+  BOOST_REQUIRE_EQUAL(Log.size(), 2);
+  BOOST_CHECK_EQUAL(Log[0], 1);
+  BOOST_CHECK_EQUAL(Log[1], 2);
+  BOOST_CHECK_EQUAL(CoTask.Task.NodeEvent.List, &Sem.Event.ListRead);
+
+  Semaphore_give(&Sem);
+  OS_scheduler();
+
+  BOOST_REQUIRE_EQUAL(Log.size(), 3);
+  BOOST_CHECK_EQUAL(Log[2], 3);
+  BOOST_CHECK(CoTask.done());
+}
+
+BOOST_AUTO_TEST_CASE(no_suspend_when_ready) {
+  Semaphore_give(&Sem);
+  CoTask.create(0, takeTwice(&Sem));
+
+  OS_scheduler();
+
+  /* First take completed without suspending. */
+  BOOST_CHECK_EQUAL(Log.size(), 2);
+  BOOST_CHECK_EQUAL(CoTask.Task.NodeEvent.List, &Sem.Event.ListRead);
+}
+
+BOOST_AUTO_TEST_CASE(queue_read) {
+  CoTask.create(0, readLoop(&Que));
+  OS_scheduler();
+
+  for (QueType x = 10; x <= 30; x += 10)
+    Queue_write(&Que, &x);
+
+  OS_scheduler();
+
+  BOOST_REQUIRE_EQUAL(Log.size(), 3);
+  BOOST_CHECK_EQUAL(Log[0], 10);
+  BOOST_CHECK_EQUAL(Log[1], 20);
+  BOOST_CHECK_EQUAL(Log[2], 30);
+  BOOST_CHECK_EQUAL(CoTask.Task.NodeEvent.List, &Que.Event.ListRead);
+}
+
+BOOST_AUTO_TEST_CASE(fifo_read) {
+  const uint8_t data[] = {5, 6, 7};
+
+  CoTask.create(0, fifoReadOnce(&Fif));
+  OS_scheduler();
+
+  Fifo_write(&Fif, &data[0], 3);
+  OS_scheduler();
+
+  BOOST_REQUIRE_EQUAL(Log.size(), 4);
+  BOOST_CHECK_EQUAL(Log[0], 3);
+  BOOST_CHECK_EQUAL(Log[1], 5);
+  BOOST_CHECK_EQUAL(Log[3], 7);
+}
+
+BOOST_AUTO_TEST_CASE(mutex_lock) {
+  struct task_t owner;
+
+  OS_taskCreate(&owner, 1, NULL, NULL);
+  setCurrentTask(&owner);
+  Mutex_lock(&Mtx);
+  setCurrentTask(NULL);
+
+  CoTask.create(0, lockOnce(&Mtx));
+  OS_scheduler();
+
+  BOOST_CHECK_EQUAL(Log.size(), 0);
+  BOOST_CHECK_EQUAL(CoTask.Task.NodeEvent.List, &Mtx.Event.ListRead);
+
+  setCurrentTask(&owner);
+  Mutex_unlock(&Mtx);
+  setCurrentTask(NULL);
+
+  OS_scheduler();
+
+  BOOST_REQUIRE_EQUAL(Log.size(), 1);
+  BOOST_CHECK_EQUAL(Log[0], 1);
+  BOOST_CHECK_EQUAL(Mutex_getOwner(&Mtx), (void *)0);
+}
+
+BOOST_AUTO_TEST_CASE(timeout) {
+  CoTask.create(0, takeLoop(&Sem, 3));
+  OS_scheduler();
+
+  tickAndSchedule(2);
+  BOOST_CHECK_EQUAL(Log.size(), 0);
+
+  tickAndSchedule(1);
+
+  /* Await returns zero on timeout. */
+  BOOST_REQUIRE_EQUAL(Log.size(), 1);
+  BOOST_CHECK_EQUAL(Log[0], 0);
+}
+
+BOOST_AUTO_TEST_CASE(woken_without_data_pends_again) {
+  CoTask.create(0, takeLoop(&Sem, 10));
+  OS_scheduler();
+
+  tickAndSchedule(4);
+
+  /* Unblocked, but the semaphore is taken before the task runs. */
+  Semaphore_give(&Sem);
+  BOOST_CHECK_EQUAL(Semaphore_take(&Sem), 1);
+  OS_scheduler();
+
+  BOOST_CHECK_EQUAL(Log.size(), 0);
+  BOOST_CHECK_EQUAL(CoTask.Task.NodeEvent.List, &Sem.Event.ListRead);
+
+  /* Pended again with the remaining ticks. */
+  tickAndSchedule(5);
+  BOOST_CHECK_EQUAL(Log.size(), 0);
+  tickAndSchedule(1);
+  BOOST_REQUIRE_EQUAL(Log.size(), 1);
+  BOOST_CHECK_EQUAL(Log[0], 0);
+}
+
+BOOST_AUTO_TEST_CASE(delay) {
+  CoTask.create(0, delayTwice());
+  OS_scheduler();
+
+  tickAndSchedule(3);
+
+  BOOST_REQUIRE_EQUAL(Log.size(), 1);
+  BOOST_CHECK_EQUAL(Log[0], 3);
+
+  tickAndSchedule(2);
+
+  BOOST_REQUIRE_EQUAL(Log.size(), 2);
+  BOOST_CHECK_EQUAL(Log[1], 5);
+}
+
+BOOST_AUTO_TEST_CASE(delay_until) {
+  CoTask.create(0, delayUntilLoop());
+  OS_scheduler();
+
+  tickAndSchedule(15);
+
+  BOOST_REQUIRE_EQUAL(Log.size(), 3);
+  BOOST_CHECK_EQUAL(Log[0], 5);
+  BOOST_CHECK_EQUAL(Log[1], 10);
+  BOOST_CHECK_EQUAL(Log[2], 15);
+}
+
+BOOST_AUTO_TEST_CASE(return_suspends_task) {
+  CoTask.create(0, returnAtOnce());
+  OS_scheduler();
+
+  BOOST_CHECK(CoTask.done());
+  BOOST_CHECK_NE(CoTask.Task.State, TASKSTATE_READY);
+
+  tickAndSchedule(3);
+
+  BOOST_CHECK_EQUAL(Log.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(create_twice) {
+  CoTask.create(0, returnAtOnce());
+
+  BOOST_CHECK_THROW(CoTask.create(1, returnAtOnce()), int);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif /* __cplusplus >= 202002L */
@@ -0,0 +1,170 @@
+#include "LibreRTOS.h"
+#include "TheHeader.h"
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+#if (LIBRERTOS_DEFER_LENGTH != 0)
+
+struct DeferFixture {
+  static const priority_t DeferPriority = LIBRERTOS_MAX_PRIORITY - 1;
+
+  static std::vector<long> calls;
+  static int repost;
+
+  static void deferFunction(void *param) { calls.push_back((long)param); }
+  static void deferFunction2(void *param) {
+    calls.push_back(100 + (long)param);
+  }
+  static void deferRepost(void *param) {
+    calls.push_back((long)param);
+    if (repost-- > 0)
+      OS_deferCall(&deferRepost, param);
+  }
+
+  DeferFixture() {
+    calls.clear();
+    repost = 0;
+
+    OS_init();
+    OS_deferTaskCreate(DeferPriority);
+    OS_start();
+  }
+  ~DeferFixture() { BOOST_CHECK_EQUAL(OSstate.SchedulerLock, 0); }
+
+  /* Run a single activation of the deferred call task. */
+  void runDeferTaskOnce(void) {
+    struct task_t *deferTask = OSstate.Task[DeferPriority];
+    setCurrentTask(deferTask);
+    deferTask->Function(deferTask->Parameter);
+    setCurrentTask(NULL);
+  }
+};
+
+std::vector<long> DeferFixture::calls;
+int DeferFixture::repost;
+
+BOOST_FIXTURE_TEST_SUITE(Defer, DeferFixture)
+
+BOOST_AUTO_TEST_CASE(create_task) {
+  BOOST_REQUIRE(OSstate.Task[DeferPriority] != NULL);
+
+  OS_scheduler();
+
+  BOOST_CHECK_EQUAL(calls.size(), 0);
+  BOOST_CHECK_EQUAL(OS_deferPending(), 0);
+  BOOST_CHECK_NE(OSstate.Task[DeferPriority]->State, TASKSTATE_READY);
+}
+
+BOOST_AUTO_TEST_CASE(call_runs_on_scheduler) {
+  BOOST_CHECK_EQUAL(OS_deferCall(&deferFunction, (void *)1), 1);
+
+  BOOST_CHECK_EQUAL(OS_deferPending(), 1);
+  BOOST_CHECK_EQUAL(OSstate.Task[DeferPriority]->State, TASKSTATE_READY);
+  BOOST_CHECK_EQUAL(calls.size(), 0);
+
+  OS_scheduler();
+
+  BOOST_REQUIRE_EQUAL(calls.size(), 1);
+  BOOST_CHECK_EQUAL(calls[0], 1);
+  BOOST_CHECK_EQUAL(OS_deferPending(), 0);
+  BOOST_CHECK_NE(OSstate.Task[DeferPriority]->State, TASKSTATE_READY);
+}
+
+BOOST_AUTO_TEST_CASE(calls_run_in_one_activation) {
+  OS_deferCall(&deferFunction, (void *)1);
+  OS_deferCall(&deferFunction2, (void *)1);
+  OS_deferCall(&deferFunction, (void *)2);
+
+  runDeferTaskOnce();
+
+  /* All pending calls, in posting order. */
+  BOOST_REQUIRE_EQUAL(calls.size(), 3);
+  BOOST_CHECK_EQUAL(calls[0], 1);
+  BOOST_CHECK_EQUAL(calls[1], 101);
+  BOOST_CHECK_EQUAL(calls[2], 2);
+  BOOST_CHECK_EQUAL(OS_deferPending(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(coalesce_pending_call) {
+  BOOST_CHECK_EQUAL(OS_deferCall(&deferFunction, (void *)1), 1);
+  BOOST_CHECK_EQUAL(OS_deferCall(&deferFunction, (void *)2), 1);
+  BOOST_CHECK_EQUAL(OS_deferCall(&deferFunction, (void *)1), 1);
+  BOOST_CHECK_EQUAL(OS_deferCall(&deferFunction2, (void *)1), 1);
+
+  /* Same function and parameter is pending only once. */
+  BOOST_CHECK_EQUAL(OS_deferPending(), 3);
+
+  OS_scheduler();
+
+  BOOST_REQUIRE_EQUAL(calls.size(), 3);
+  BOOST_CHECK_EQUAL(calls[0], 1);
+  BOOST_CHECK_EQUAL(calls[1], 2);
+  BOOST_CHECK_EQUAL(calls[2], 101);
+
+  /* After running it can be posted again. */
+  OS_deferCall(&deferFunction, (void *)1);
+  OS_scheduler();
+
+  BOOST_REQUIRE_EQUAL(calls.size(), 4);
+  BOOST_CHECK_EQUAL(calls[3], 1);
+}
+
+BOOST_AUTO_TEST_CASE(queue_full) {
+  for (long i = 0; i < LIBRERTOS_DEFER_LENGTH; ++i)
+    BOOST_CHECK_EQUAL(OS_deferCall(&deferFunction, (void *)i), 1);
+
+  BOOST_CHECK_EQUAL(OS_deferLost(), 0);
+
+  BOOST_CHECK_EQUAL(
+      OS_deferCall(&deferFunction, (void *)(long)LIBRERTOS_DEFER_LENGTH), 0);
+  BOOST_CHECK_EQUAL(OS_deferLost(), 1);
+
+  /* Pending call is coalesced even when the queue is full. */
+  BOOST_CHECK_EQUAL(OS_deferCall(&deferFunction, (void *)0), 1);
+  BOOST_CHECK_EQUAL(OS_deferLost(), 1);
+
+  OS_scheduler();
+
+  BOOST_CHECK_EQUAL(calls.size(), LIBRERTOS_DEFER_LENGTH);
+  BOOST_CHECK_EQUAL(OS_deferPending(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(call_posted_by_call_runs_next_activation) {
+  repost = 1;
+  OS_deferCall(&deferRepost, (void *)5);
+
+  runDeferTaskOnce();
+
+  /* The activation is bounded to the calls pending when it started. */
+  BOOST_CHECK_EQUAL(calls.size(), 1);
+  BOOST_CHECK_EQUAL(OS_deferPending(), 1);
+  BOOST_CHECK_EQUAL(OSstate.Task[DeferPriority]->State, TASKSTATE_READY);
+
+  OS_scheduler();
+
+  BOOST_CHECK_EQUAL(calls.size(), 2);
+  BOOST_CHECK_EQUAL(OS_deferPending(), 0);
+}
+
+void defer_concurrent(void) {
+  librertos_test_set_concurrent_behavior(0);
+  BOOST_CHECK_EQUAL(OS_deferCall(&DeferFixture::deferFunction, (void *)2), 1);
+}
+
+BOOST_AUTO_TEST_CASE(call_concurrent) {
+  librertos_test_set_concurrent_behavior(&defer_concurrent);
+
+  BOOST_CHECK_EQUAL(OS_deferCall(&deferFunction, (void *)1), 1);
+
+  librertos_test_set_concurrent_behavior(0);
+
+  BOOST_CHECK_EQUAL(OS_deferPending(), 2);
+
+  OS_scheduler();
+
+  BOOST_CHECK_EQUAL(calls.size(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif /* LIBRERTOS_DEFER_LENGTH */
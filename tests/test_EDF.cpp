@@ -0,0 +1,252 @@
+#include "LibreRTOS.h"
+#include "TheHeader.h"
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+#if (LIBRERTOS_EDF != 0)
+
+/* Built with earliest-deadline-first scheduling enabled:
+ scripts/run_config_tests.sh "-DLIBRERTOS_EDF=1" */
+
+static std::vector<struct task_t *> runs;
+
+static void taskRecord(taskParameter_t param) {
+  (void)param;
+  runs.push_back(OS_getCurrentTask());
+
+  /* Delay so scheduler does not reschedule task to run again. */
+  OS_taskDelay(MAX_DELAY);
+}
+
+static void taskPeriodic(taskParameter_t param) {
+  runs.push_back(OS_getCurrentTask());
+  OS_taskDelay((tick_t)(long)param);
+}
+
+struct EdfFixture {
+  static const int NumTasks = 8;
+
+  struct task_t Task[NumTasks];
+  struct Semaphore_t Sem;
+
+  EdfFixture() {
+    runs.clear();
+
+    OS_init();
+    OS_start();
+
+    Semaphore_init(&Sem, 0, 1);
+  }
+  ~EdfFixture() { BOOST_CHECK_EQUAL(OSstate.SchedulerLock, 0); }
+
+  void createEdf(int i, tick_t deadline) {
+    OS_taskCreate(&Task[i], (priority_t)i, &taskRecord, NULL);
+    OS_taskSetDeadline(&Task[i], deadline);
+  }
+
+  void tickAndSchedule(tick_t ticks) {
+    for (tick_t i = 0; i < ticks; ++i) {
+      OS_tick();
+      OS_scheduler();
+    }
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(EDF, EdfFixture)
+
+BOOST_AUTO_TEST_CASE(fixed_priority_by_default) {
+  OS_taskCreate(&Task[0], 0, &taskRecord, NULL);
+
+  BOOST_CHECK_EQUAL(Task[0].RelativeDeadline, 0);
+  BOOST_CHECK_EQUAL(OS_taskGetDeadlineMisses(&Task[0]), 0);
+}
+
+BOOST_AUTO_TEST_CASE(set_deadline) {
+  OSstate.Tick = 7;
+  createEdf(0, 10);
+
+  /* Ready task, released now. */
+  BOOST_CHECK_EQUAL(Task[0].RelativeDeadline, 10);
+  BOOST_CHECK_EQUAL(OS_taskGetDeadline(&Task[0]), 17);
+}
+
+BOOST_AUTO_TEST_CASE(set_deadline_zero) {
+  createEdf(0, 10);
+  OS_taskCreate(&Task[1], 1, &taskRecord, NULL);
+
+  /* Back to fixed priority. */
+  OS_taskSetDeadline(&Task[0], 0);
+  OS_scheduler();
+
+  BOOST_REQUIRE_EQUAL(runs.size(), 2);
+  BOOST_CHECK_EQUAL(runs[0], &Task[1]);
+  BOOST_CHECK_EQUAL(runs[1], &Task[0]);
+}
+
+BOOST_AUTO_TEST_CASE(earliest_deadline_first) {
+  createEdf(0, 5);
+  createEdf(1, 20);
+  createEdf(2, 10);
+
+  OS_scheduler();
+
+  /* Not in priority order. */
+  BOOST_REQUIRE_EQUAL(runs.size(), 3);
+  BOOST_CHECK_EQUAL(runs[0], &Task[0]);
+  BOOST_CHECK_EQUAL(runs[1], &Task[2]);
+  BOOST_CHECK_EQUAL(runs[2], &Task[1]);
+}
+
+BOOST_AUTO_TEST_CASE(equal_deadlines_by_priority) {
+  createEdf(0, 10);
+  createEdf(1, 10);
+
+  OS_scheduler();
+
+  BOOST_REQUIRE_EQUAL(runs.size(), 2);
+  BOOST_CHECK_EQUAL(runs[0], &Task[1]);
+  BOOST_CHECK_EQUAL(runs[1], &Task[0]);
+}
+
+BOOST_AUTO_TEST_CASE(fixed_priority_background) {
+  OS_taskCreate(&Task[NumTasks - 1], NumTasks - 1, &taskRecord, NULL);
+  createEdf(0, 100);
+
+  OS_scheduler();
+
+  /* EDF tasks before fixed-priority tasks of any priority. */
+  BOOST_REQUIRE_EQUAL(runs.size(), 2);
+  BOOST_CHECK_EQUAL(runs[0], &Task[0]);
+  BOOST_CHECK_EQUAL(runs[1], &Task[NumTasks - 1]);
+}
+
+BOOST_AUTO_TEST_CASE(many_tasks) {
+  const tick_t deadlines[NumTasks] = {40, 15, 70, 5, 55, 25, 60, 10};
+
+  for (int i = 0; i < NumTasks; ++i)
+    createEdf(i, deadlines[i]);
+
+  OS_scheduler();
+
+  BOOST_REQUIRE_EQUAL(runs.size(), (size_t)NumTasks);
+  for (int i = 1; i < NumTasks; ++i)
+    BOOST_CHECK_LT(OS_taskGetDeadline(runs[i - 1]),
+                   OS_taskGetDeadline(runs[i]));
+}
+
+BOOST_AUTO_TEST_CASE(release_after_delay) {
+  OS_taskCreate(&Task[0], 0, &taskPeriodic, (void *)5);
+  OS_taskSetDeadline(&Task[0], 3);
+
+  OS_scheduler();
+  BOOST_CHECK_EQUAL(OS_taskGetDeadline(&Task[0]), 3);
+
+  tickAndSchedule(5);
+
+  /* New deadline from the release at tick 5. */
+  BOOST_CHECK_EQUAL(runs.size(), 2);
+  BOOST_CHECK_EQUAL(OS_taskGetDeadline(&Task[0]), 8);
+}
+
+BOOST_AUTO_TEST_CASE(release_after_delay_until) {
+  tick_t lastWake = 0;
+
+  createEdf(0, 4);
+  setCurrentTask(&Task[0]);
+
+  /* Task ran for 3 ticks, released at the period. */
+  OSstate.Tick = 3;
+  OS_taskDelayUntil(&lastWake, 10);
+  setCurrentTask(NULL);
+
+  OS_schedulerLock();
+  for (int i = 0; i < 7; ++i)
+    OS_tick();
+  OS_schedulerUnlock();
+
+  BOOST_CHECK_EQUAL(Task[0].State, TASKSTATE_READY);
+  BOOST_CHECK_EQUAL(OS_taskGetDeadline(&Task[0]), 14);
+}
+
+BOOST_AUTO_TEST_CASE(release_by_event) {
+  createEdf(0, 6);
+  setCurrentTask(&Task[0]);
+  Semaphore_pend(&Sem, MAX_DELAY);
+  setCurrentTask(NULL);
+
+  OSstate.Tick = 4;
+  Semaphore_give(&Sem);
+
+  BOOST_CHECK_EQUAL(Task[0].NodeEvent.List, (void *)0);
+  BOOST_CHECK_EQUAL(OS_taskGetDeadline(&Task[0]), 10);
+}
+
+BOOST_AUTO_TEST_CASE(released_task_runs_first) {
+  createEdf(1, 20);
+  createEdf(0, 1);
+
+  setCurrentTask(&Task[0]);
+  OS_taskDelay(2);
+  setCurrentTask(NULL);
+
+  OS_schedulerLock();
+  OS_tick();
+  OS_tick();
+  OS_schedulerUnlock();
+
+  /* Released at tick 2 with deadline 3, before the task that was already
+   ready with deadline 20. */
+  OS_scheduler();
+
+  BOOST_REQUIRE_EQUAL(runs.size(), 2);
+  BOOST_CHECK_EQUAL(runs[0], &Task[0]);
+  BOOST_CHECK_EQUAL(runs[1], &Task[1]);
+}
+
+BOOST_AUTO_TEST_CASE(deadline_miss) {
+  createEdf(0, 2);
+
+  OS_schedulerLock();
+  for (int i = 0; i < 3; ++i)
+    OS_tick();
+  OS_schedulerUnlock();
+
+  OS_scheduler();
+
+  /* Started after its deadline. */
+  BOOST_CHECK_EQUAL(runs.size(), 1);
+  BOOST_CHECK_EQUAL(OS_taskGetDeadlineMisses(&Task[0]), 1);
+}
+
+BOOST_AUTO_TEST_CASE(deadline_met) {
+  createEdf(0, 2);
+
+  OS_schedulerLock();
+  OS_tick();
+  OS_tick();
+  OS_schedulerUnlock();
+
+  OS_scheduler();
+
+  BOOST_CHECK_EQUAL(OS_taskGetDeadlineMisses(&Task[0]), 0);
+}
+
+BOOST_AUTO_TEST_CASE(deadline_tick_overflow) {
+  OSstate.Tick = (tick_t)(MAX_DELAY - 2);
+
+  createEdf(0, 5);
+  createEdf(1, 1);
+
+  /* Deadline of task 0 wrapped around, still the later one. */
+  BOOST_CHECK_EQUAL(OS_taskGetDeadline(&Task[0]), 2);
+
+  OS_scheduler();
+
+  BOOST_REQUIRE_EQUAL(runs.size(), 2);
+  BOOST_CHECK_EQUAL(runs[0], &Task[1]);
+  BOOST_CHECK_EQUAL(runs[1], &Task[0]);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif /* LIBRERTOS_EDF */
@@ -69,16 +69,20 @@ BOOST_AUTO_TEST_CASE(init) {
   BOOST_CHECK_EQUAL(Fif.Buff, (void *)&FifBuff[0]);
   BOOST_CHECK_EQUAL((void *)Fif.BufEnd, (void *)&FifBuff[Len - 1]);
 
+#if (LIBRERTOS_COMPACT_LISTS == 0)
   struct taskListNode_t *nodeHead;
 
   nodeHead = (struct taskListNode_t *)&Fif.Event.ListRead;
   BOOST_CHECK_EQUAL(Fif.Event.ListRead.Head, nodeHead);
   BOOST_CHECK_EQUAL(Fif.Event.ListRead.Tail, nodeHead);
+#endif
   BOOST_CHECK_EQUAL(Fif.Event.ListRead.Length, 0);
 
+#if (LIBRERTOS_COMPACT_LISTS == 0)
   nodeHead = (struct taskListNode_t *)&Fif.Event.ListWrite;
   BOOST_CHECK_EQUAL(Fif.Event.ListWrite.Head, nodeHead);
   BOOST_CHECK_EQUAL(Fif.Event.ListWrite.Tail, nodeHead);
+#endif
   BOOST_CHECK_EQUAL(Fif.Event.ListWrite.Length, 0);
 }
 
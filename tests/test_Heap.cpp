@@ -0,0 +1,295 @@
+#include "LibreRTOS.h"
+#include "TheHeader.h"
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+#include <map>
+#include <random>
+#include <vector>
+
+#if (LIBRERTOS_HEAP != 0)
+
+struct HeapFixture {
+  static const int HeapWords = 512;
+
+  /* Heap memory, aligned for any kernel object. */
+  uint64_t HeapBuff[HeapWords];
+
+  struct OSheapStatistics_t Initial;
+
+  HeapFixture() {
+    OS_init();
+    OS_start();
+
+    OS_heapInit(&HeapBuff[0], sizeof(HeapBuff));
+    OS_heapGetStatistics(&Initial);
+  }
+  ~HeapFixture() { BOOST_CHECK_EQUAL(OSstate.SchedulerLock, 0); }
+
+  struct OSheapStatistics_t statistics() {
+    struct OSheapStatistics_t stats;
+    OS_heapGetStatistics(&stats);
+    return stats;
+  }
+
+  /* Allocated memory must be aligned and inside the heap buffer. */
+  void checkBlock(void *block, size_t size) {
+    const uint8_t *p = (const uint8_t *)block;
+    BOOST_CHECK(p >= (const uint8_t *)&HeapBuff[0]);
+    BOOST_CHECK(p + size <= (const uint8_t *)&HeapBuff[HeapWords]);
+    BOOST_CHECK_EQUAL((uintptr_t)p % sizeof(void *), 0);
+  }
+
+  static void timerFunction(struct Timer_t *, void *) {}
+};
+
+BOOST_FIXTURE_TEST_SUITE(Heap, HeapFixture)
+
+BOOST_AUTO_TEST_CASE(init) {
+  /* Part of the memory is used by the heap control structure. */
+  BOOST_CHECK_GT(Initial.TotalSize, 0);
+  BOOST_CHECK_LE(Initial.TotalSize, sizeof(HeapBuff));
+
+  BOOST_CHECK_EQUAL(Initial.FreeSize, Initial.TotalSize);
+  BOOST_CHECK_EQUAL(Initial.MinFreeSize, Initial.FreeSize);
+  BOOST_CHECK_EQUAL(Initial.LargestFreeBlock, Initial.FreeSize);
+  BOOST_CHECK_EQUAL(Initial.FreeBlocks, 1);
+
+  BOOST_CHECK_EQUAL(Initial.Allocations, 0);
+  BOOST_CHECK_EQUAL(Initial.Frees, 0);
+  BOOST_CHECK_EQUAL(Initial.Failures, 0);
+}
+
+BOOST_AUTO_TEST_CASE(alloc_and_free) {
+  const size_t size = 100;
+
+  void *block = OS_heapAlloc(size);
+
+  BOOST_REQUIRE(block != NULL);
+  checkBlock(block, size);
+  std::memset(block, 0xA5, size);
+
+  struct OSheapStatistics_t stats = statistics();
+  BOOST_CHECK_LE(stats.FreeSize, Initial.FreeSize - size);
+  BOOST_CHECK_EQUAL(stats.MinFreeSize, stats.FreeSize);
+  BOOST_CHECK_EQUAL(stats.Allocations, 1);
+
+  OS_heapFree(block);
+
+  stats = statistics();
+  BOOST_CHECK_EQUAL(stats.FreeSize, Initial.FreeSize);
+  BOOST_CHECK_EQUAL(stats.LargestFreeBlock, Initial.LargestFreeBlock);
+  BOOST_CHECK_EQUAL(stats.FreeBlocks, 1);
+  BOOST_CHECK_EQUAL(stats.Frees, 1);
+
+  /* Low-water mark is kept. */
+  BOOST_CHECK_LT(stats.MinFreeSize, Initial.FreeSize);
+}
+
+BOOST_AUTO_TEST_CASE(alloc_free_alloc_same_block) {
+  void *block = OS_heapAlloc(40);
+  OS_heapFree(block);
+
+  BOOST_CHECK_EQUAL(OS_heapAlloc(40), block);
+}
+
+BOOST_AUTO_TEST_CASE(alloc_zero) {
+  BOOST_CHECK_EQUAL(OS_heapAlloc(0), (void *)NULL);
+  BOOST_CHECK_EQUAL(statistics().FreeSize, Initial.FreeSize);
+}
+
+BOOST_AUTO_TEST_CASE(alloc_too_large) {
+  BOOST_CHECK_EQUAL(OS_heapAlloc(sizeof(HeapBuff)), (void *)NULL);
+  BOOST_CHECK_EQUAL(OS_heapAlloc(Initial.LargestFreeBlock + 1), (void *)NULL);
+
+  struct OSheapStatistics_t stats = statistics();
+  BOOST_CHECK_EQUAL(stats.FreeSize, Initial.FreeSize);
+  BOOST_CHECK_EQUAL(stats.Allocations, 0);
+  BOOST_CHECK_EQUAL(stats.Failures, 2);
+}
+
+BOOST_AUTO_TEST_CASE(free_null) {
+  OS_heapFree(NULL);
+
+  BOOST_CHECK_EQUAL(statistics().Frees, 0);
+}
+
+BOOST_AUTO_TEST_CASE(free_merges_neighbors) {
+  void *block1 = OS_heapAlloc(64);
+  void *block2 = OS_heapAlloc(64);
+  void *block3 = OS_heapAlloc(64);
+  void *block4 = OS_heapAlloc(64);
+
+  /* Fragmented: block2 is used between two free blocks. */
+  OS_heapFree(block1);
+  OS_heapFree(block3);
+
+  struct OSheapStatistics_t stats = statistics();
+  BOOST_CHECK_EQUAL(stats.FreeBlocks, 3);
+  BOOST_CHECK_LT(stats.LargestFreeBlock, stats.FreeSize);
+
+  /* Freeing block2 merges it with both neighbors. */
+  OS_heapFree(block2);
+
+  stats = statistics();
+  BOOST_CHECK_EQUAL(stats.FreeBlocks, 2);
+
+  OS_heapFree(block4);
+
+  stats = statistics();
+  BOOST_CHECK_EQUAL(stats.FreeSize, Initial.FreeSize);
+  BOOST_CHECK_EQUAL(stats.LargestFreeBlock, Initial.LargestFreeBlock);
+  BOOST_CHECK_EQUAL(stats.FreeBlocks, 1);
+}
+
+BOOST_AUTO_TEST_CASE(random_alloc_free) {
+  std::mt19937 gen(1);
+  std::uniform_int_distribution<size_t> sizeDist(1, 200);
+  std::map<uint8_t *, size_t> blocks;
+  uint8_t fill = 0;
+
+  for (int i = 0; i < 2000; ++i) {
+    if (blocks.empty() || gen() % 2 == 0) {
+      size_t size = sizeDist(gen);
+      uint8_t *block = (uint8_t *)OS_heapAlloc(size);
+      if (block == NULL)
+        continue;
+
+      checkBlock(block, size);
+      std::memset(block, ++fill, size);
+
+      /* Must not overlap the neighbor blocks. */
+      std::map<uint8_t *, size_t>::iterator next = blocks.lower_bound(block);
+      if (next != blocks.end())
+        BOOST_REQUIRE(block + size <= next->first);
+      if (next != blocks.begin()) {
+        --next;
+        BOOST_REQUIRE(next->first + next->second <= block);
+      }
+
+      blocks[block] = size;
+    } else {
+      std::map<uint8_t *, size_t>::iterator it = blocks.begin();
+      std::advance(it, gen() % blocks.size());
+
+      /* Content was not changed by other allocations. */
+      for (size_t j = 1; j < it->second; ++j)
+        BOOST_REQUIRE_EQUAL(it->first[j], it->first[0]);
+
+      OS_heapFree(it->first);
+      blocks.erase(it);
+    }
+  }
+
+  while (!blocks.empty()) {
+    OS_heapFree(blocks.begin()->first);
+    blocks.erase(blocks.begin());
+  }
+
+  struct OSheapStatistics_t stats = statistics();
+  BOOST_CHECK_EQUAL(stats.FreeSize, Initial.FreeSize);
+  BOOST_CHECK_EQUAL(stats.LargestFreeBlock, Initial.LargestFreeBlock);
+  BOOST_CHECK_EQUAL(stats.FreeBlocks, 1);
+  BOOST_CHECK_EQUAL(stats.Allocations, stats.Frees);
+}
+
+BOOST_AUTO_TEST_CASE(queue_create_delete) {
+  const len_t length = 3;
+  const uint32_t x = 0x12345678;
+  uint32_t y = 0;
+
+  struct Queue_t *que = OS_queueCreate(length, sizeof(x));
+
+  BOOST_REQUIRE(que != NULL);
+  checkBlock(que, sizeof(*que));
+  BOOST_CHECK_EQUAL(Queue_length(que), length);
+  BOOST_CHECK_EQUAL(Queue_itemSize(que), sizeof(x));
+  BOOST_CHECK_LE(statistics().FreeSize,
+                 Initial.FreeSize - sizeof(*que) - length * sizeof(x));
+
+  BOOST_CHECK_EQUAL(Queue_write(que, &x), 1);
+  BOOST_CHECK_EQUAL(Queue_read(que, &y), 1);
+  BOOST_CHECK_EQUAL(y, x);
+
+  OS_queueDelete(que);
+
+  BOOST_CHECK_EQUAL(statistics().FreeSize, Initial.FreeSize);
+}
+
+BOOST_AUTO_TEST_CASE(queue_delete_with_pending_task) {
+  struct task_t task;
+  struct Queue_t *que = OS_queueCreate(1, 1);
+
+  OS_taskCreate(&task, 0, NULL, NULL);
+  setCurrentTask(&task);
+  Queue_pendRead(que, 1);
+
+  /* The waiting task would be left on a freed list. */
+  BOOST_CHECK_THROW(OS_queueDelete(que), int);
+}
+
+BOOST_AUTO_TEST_CASE(fifo_create_delete) {
+  const len_t length = 10;
+  uint8_t x = 0x5A;
+
+  struct Fifo_t *fif = OS_fifoCreate(length);
+
+  BOOST_REQUIRE(fif != NULL);
+  checkBlock(fif, sizeof(*fif));
+  BOOST_CHECK_EQUAL(Fifo_length(fif), length);
+  BOOST_CHECK_LE(statistics().FreeSize,
+                 Initial.FreeSize - sizeof(*fif) - length);
+
+  BOOST_CHECK_EQUAL(Fifo_write(fif, &x, 1), 1);
+  x = 0;
+  BOOST_CHECK_EQUAL(Fifo_read(fif, &x, 1), 1);
+  BOOST_CHECK_EQUAL(x, 0x5A);
+
+  OS_fifoDelete(fif);
+
+  BOOST_CHECK_EQUAL(statistics().FreeSize, Initial.FreeSize);
+}
+
+#if (LIBRERTOS_SOFTWARETIMERS != 0)
+BOOST_AUTO_TEST_CASE(timer_create_delete) {
+  struct Timer_t *timer =
+      OS_timerCreate(TIMERTYPE_AUTO, 5, &timerFunction, (void *)1);
+
+  BOOST_REQUIRE(timer != NULL);
+  checkBlock(timer, sizeof(*timer));
+  BOOST_CHECK_EQUAL(timer->Period, 5);
+  BOOST_CHECK_EQUAL(timer->Parameter, (void *)1);
+  BOOST_CHECK_EQUAL(Timer_isRunning(timer), 0);
+
+  /* Running timers are stopped before they are freed. */
+  Timer_start(timer);
+  OS_timerDelete(timer);
+
+  BOOST_CHECK_EQUAL(OSstate.TimerUnorderedList.Length, 0);
+  BOOST_CHECK_EQUAL(OSstate.TimerList.Length, 0);
+  BOOST_CHECK_EQUAL(statistics().FreeSize, Initial.FreeSize);
+}
+#endif
+
+BOOST_AUTO_TEST_CASE(create_on_full_heap) {
+  std::vector<void *> blocks;
+  void *block;
+
+  while ((block = OS_heapAlloc(1)) != NULL)
+    blocks.push_back(block);
+
+  BOOST_CHECK_EQUAL(OS_queueCreate(1, 1), (void *)NULL);
+  BOOST_CHECK_EQUAL(OS_fifoCreate(1), (void *)NULL);
+#if (LIBRERTOS_SOFTWARETIMERS != 0)
+  BOOST_CHECK_EQUAL(OS_timerCreate(TIMERTYPE_ONESHOT, 1, &timerFunction, NULL),
+                    (void *)NULL);
+#endif
+
+  for (size_t i = 0; i < blocks.size(); ++i)
+    OS_heapFree(blocks[i]);
+
+  BOOST_CHECK_EQUAL(statistics().FreeSize, Initial.FreeSize);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif /* LIBRERTOS_HEAP */
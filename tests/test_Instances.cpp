@@ -0,0 +1,232 @@
+#include "LibreRTOS.h"
+#include "TheHeader.h"
+#include <boost/test/unit_test.hpp>
+#include <thread>
+#include <vector>
+
+#if (LIBRERTOS_MULTIPLE_INSTANCES != 0)
+
+/* Built with multiple instances enabled:
+ scripts/run_config_tests.sh "-DLIBRERTOS_MULTIPLE_INSTANCES=1 -pthread" */
+
+struct InstancesFixture {
+  static const int Len = 4;
+
+  struct libreRtosState_t *Default;
+  struct libreRtosState_t InstanceA;
+  struct libreRtosState_t InstanceB;
+
+  struct task_t TaskA;
+  struct task_t TaskB;
+
+  struct Channel_t Chan;
+  uint32_t ChanBuff[Len];
+
+  InstancesFixture() {
+    Default = OS_instanceGet();
+
+    OS_instanceSelect(&InstanceA);
+    OS_init();
+    OS_start();
+
+    OS_instanceSelect(&InstanceB);
+    OS_init();
+    OS_start();
+
+    Channel_init(&Chan, &ChanBuff[0], Len, (len_t)sizeof(uint32_t));
+  }
+  ~InstancesFixture() {
+    OS_instanceSelect(&InstanceA);
+    BOOST_CHECK_EQUAL(OSstate.SchedulerLock, 0);
+    OS_instanceSelect(&InstanceB);
+    BOOST_CHECK_EQUAL(OSstate.SchedulerLock, 0);
+
+    OS_instanceSelect(Default);
+  }
+};
+
+const int InstancesFixture::Len;
+
+static std::vector<uint32_t> received;
+static struct Channel_t *readerChannel;
+
+static void channelReader(taskParameter_t param) {
+  uint32_t x;
+  (void)param;
+
+  while (Channel_readPend(readerChannel, &x, MAX_DELAY))
+    received.push_back(x);
+}
+
+BOOST_FIXTURE_TEST_SUITE(Instances, InstancesFixture)
+
+BOOST_AUTO_TEST_CASE(default_instance) {
+  BOOST_CHECK(Default != NULL);
+  BOOST_CHECK(Default != &InstanceA);
+  BOOST_CHECK(Default != &InstanceB);
+}
+
+BOOST_AUTO_TEST_CASE(select) {
+  OS_instanceSelect(&InstanceA);
+  BOOST_CHECK_EQUAL(OS_instanceGet(), &InstanceA);
+  BOOST_CHECK_EQUAL(&OSstate, &InstanceA);
+
+  OS_instanceSelect(&InstanceB);
+  BOOST_CHECK_EQUAL(OS_instanceGet(), &InstanceB);
+  BOOST_CHECK_EQUAL(&OSstate, &InstanceB);
+}
+
+BOOST_AUTO_TEST_CASE(select_null) {
+  OS_instanceSelect(&InstanceA);
+
+  BOOST_CHECK_THROW(OS_instanceSelect(NULL), int);
+  BOOST_CHECK_EQUAL(OS_instanceGet(), &InstanceA);
+}
+
+BOOST_AUTO_TEST_CASE(independent_state) {
+  OS_instanceSelect(&InstanceA);
+  OS_taskCreate(&TaskA, 0, NULL, NULL);
+  OS_tick();
+  OS_tick();
+
+  OS_instanceSelect(&InstanceB);
+  OS_taskCreate(&TaskB, 0, NULL, NULL);
+  OS_tick();
+
+  /* Same priority, each instance has its own task table and tick. */
+  BOOST_CHECK_EQUAL(InstanceA.Task[0], &TaskA);
+  BOOST_CHECK_EQUAL(InstanceB.Task[0], &TaskB);
+  BOOST_CHECK_EQUAL(OS_getTickCount(), 1);
+
+  OS_instanceSelect(&InstanceA);
+  BOOST_CHECK_EQUAL(OS_getTickCount(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(delay_in_own_instance) {
+  OS_instanceSelect(&InstanceA);
+  OS_taskCreate(&TaskA, 0, NULL, NULL);
+  setCurrentTask(&TaskA);
+  OS_taskDelay(1);
+  setCurrentTask(NULL);
+
+  BOOST_CHECK_EQUAL(TaskA.NodeDelay.List, &InstanceA.BlockedTaskList1);
+  BOOST_CHECK_EQUAL(InstanceB.BlockedTaskList1.Length, 0);
+}
+
+BOOST_AUTO_TEST_CASE(select_per_thread) {
+  struct libreRtosState_t *selected = NULL;
+
+  OS_instanceSelect(&InstanceA);
+
+  std::thread thread([&]() {
+    /* A new thread starts with the default instance. */
+    selected = OS_instanceGet();
+    OS_instanceSelect(&InstanceB);
+  });
+  thread.join();
+
+  BOOST_CHECK_EQUAL(selected, Default);
+  BOOST_CHECK_EQUAL(OS_instanceGet(), &InstanceA);
+}
+
+BOOST_AUTO_TEST_CASE(channel_write_read) {
+  uint32_t x;
+
+  BOOST_CHECK_EQUAL(Channel_used(&Chan), 0);
+  BOOST_CHECK_EQUAL(Channel_read(&Chan, &x), 0);
+
+  for (uint32_t i = 0; i < (uint32_t)Len; ++i)
+    BOOST_CHECK_EQUAL(Channel_write(&Chan, &i), 1);
+
+  x = Len;
+  BOOST_CHECK_EQUAL(Channel_write(&Chan, &x), 0);
+  BOOST_CHECK_EQUAL(Channel_used(&Chan), Len);
+
+  for (uint32_t i = 0; i < (uint32_t)Len; ++i) {
+    BOOST_CHECK_EQUAL(Channel_read(&Chan, &x), 1);
+    BOOST_CHECK_EQUAL(x, i);
+  }
+
+  BOOST_CHECK_EQUAL(Channel_read(&Chan, &x), 0);
+}
+
+BOOST_AUTO_TEST_CASE(channel_wrap) {
+  uint32_t x;
+
+  for (uint32_t i = 0; i < 3 * (uint32_t)Len; ++i) {
+    BOOST_CHECK_EQUAL(Channel_write(&Chan, &i), 1);
+    BOOST_CHECK_EQUAL(Channel_read(&Chan, &x), 1);
+    BOOST_CHECK_EQUAL(x, i);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(channel_pend_read) {
+  OS_instanceSelect(&InstanceA);
+  OS_taskCreate(&TaskA, 0, NULL, NULL);
+  setCurrentTask(&TaskA);
+  Channel_pendRead(&Chan, 1);
+  setCurrentTask(NULL);
+
+  /* Pended in the instance of the reader. */
+  BOOST_CHECK_EQUAL(TaskA.State, TASKSTATE_BLOCKED);
+  BOOST_CHECK_EQUAL(TaskA.NodeDelay.List, &InstanceA.BlockedTaskList1);
+}
+
+BOOST_AUTO_TEST_CASE(channel_wake_reader_in_other_instance) {
+  uint32_t x = 7;
+
+  received.clear();
+  readerChannel = &Chan;
+
+  OS_instanceSelect(&InstanceA);
+  OS_taskCreate(&TaskA, 0, &channelReader, NULL);
+  OS_scheduler();
+
+  BOOST_CHECK_EQUAL(TaskA.State, TASKSTATE_BLOCKED);
+
+  /* Written by instance B, the task of instance A is not touched. */
+  OS_instanceSelect(&InstanceB);
+  BOOST_CHECK_EQUAL(Channel_write(&Chan, &x), 1);
+  BOOST_CHECK_EQUAL(TaskA.State, TASKSTATE_BLOCKED);
+
+  /* Reader unblocked by the scheduler of its instance. */
+  OS_instanceSelect(&InstanceA);
+  OS_scheduler();
+
+  BOOST_REQUIRE_EQUAL(received.size(), 1);
+  BOOST_CHECK_EQUAL(received[0], 7);
+  BOOST_CHECK_EQUAL(TaskA.State, TASKSTATE_BLOCKED);
+}
+
+BOOST_AUTO_TEST_CASE(channel_threads) {
+  const uint32_t n = 100000;
+  bool ordered = true;
+  uint32_t next = 0;
+
+  /* One producer and one consumer thread, each with its own instance. */
+  std::thread producer([&]() {
+    OS_instanceSelect(&InstanceB);
+    for (uint32_t i = 0; i < n;)
+      if (Channel_write(&Chan, &i))
+        ++i;
+  });
+
+  OS_instanceSelect(&InstanceA);
+  while (next < n) {
+    uint32_t x;
+    if (Channel_read(&Chan, &x)) {
+      if (x != next)
+        ordered = false;
+      ++next;
+    }
+  }
+
+  producer.join();
+
+  BOOST_CHECK(ordered);
+  BOOST_CHECK_EQUAL(Channel_used(&Chan), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif /* LIBRERTOS_MULTIPLE_INSTANCES */
@@ -0,0 +1,428 @@
+#include "LibreRTOS.h"
+#include "TheHeader.h"
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+
+typedef uint64_t MsgType;
+
+struct MessageBufferFixture {
+  static const int MsgSize = 4;
+  static const MsgType MsgGuard = 0xFA57C0DEFA57C0DE;
+
+  static const int Len = MsgSize * (int)sizeof(MsgType);
+
+  /* Each message is stored after its length. */
+  static const int Prefix = (int)sizeof(len_t);
+
+  /* Buffer with guards at begin and end. */
+  const MsgType Guard = MsgGuard;
+  MsgType MsgBuff_WithGuards[MsgSize + 2];
+
+  struct MessageBuffer_t Msg;
+  uint8_t *MsgBuff = (uint8_t *)&MsgBuff_WithGuards[1];
+
+  struct task_t Task1;
+
+  MessageBufferFixture() {
+    OS_init();
+    OS_start();
+
+    MsgBuff_WithGuards[0] = Guard;
+    MsgBuff_WithGuards[MsgSize + 1] = Guard;
+
+    MessageBuffer_init(&Msg, &MsgBuff[0], (len_t)Len);
+
+    OS_taskCreate(&Task1, 0, NULL, NULL);
+  }
+  ~MessageBufferFixture() {
+    BOOST_CHECK_EQUAL(OSstate.SchedulerLock, 0);
+
+    /* These should not change after initialization. */
+    BOOST_CHECK_EQUAL(MessageBuffer_length(&Msg), Len);
+
+    /* These should be zero after operations are complete. */
+    BOOST_CHECK_EQUAL(Msg.Fifo.WLock, 0);
+    BOOST_CHECK_EQUAL(Msg.Fifo.RLock, 0);
+
+    /* Check overflow guards. */
+    BOOST_CHECK_EQUAL(MsgBuff_WithGuards[0], Guard);
+    BOOST_CHECK_EQUAL(MsgBuff_WithGuards[MsgSize + 1], Guard);
+  }
+
+  /* Write messages of length bytes until the buffer is full. */
+  int fill(len_t length) {
+    uint8_t x[Len];
+    int n = 0;
+    std::memset(x, 0, sizeof(x));
+    while (MessageBuffer_write(&Msg, x, length))
+      x[0] = (uint8_t)++n;
+    return n;
+  }
+};
+
+const int MessageBufferFixture::Len;
+const int MessageBufferFixture::Prefix;
+
+BOOST_FIXTURE_TEST_SUITE(MessageBuffer, MessageBufferFixture)
+
+BOOST_AUTO_TEST_CASE(init) {
+  uint8_t x[Len];
+
+  BOOST_CHECK_EQUAL(MessageBuffer_nextLength(&Msg), 0);
+  BOOST_CHECK_EQUAL(MessageBuffer_free(&Msg), Len - Prefix);
+  BOOST_CHECK_EQUAL(MessageBuffer_read(&Msg, x, sizeof(x)), 0);
+
+#if (LIBRERTOS_COMPACT_LISTS == 0)
+  const struct taskListNode_t *nodeHead =
+      (struct taskListNode_t *)&Msg.Fifo.Event.ListRead;
+  BOOST_CHECK_EQUAL(Msg.Fifo.Event.ListRead.Head, nodeHead);
+#endif
+  BOOST_CHECK_EQUAL(Msg.Fifo.Event.ListRead.Length, 0);
+}
+
+BOOST_AUTO_TEST_CASE(write_read) {
+  const char msg[] = "hello";
+  char x[Len];
+
+  BOOST_CHECK_EQUAL(MessageBuffer_write(&Msg, msg, sizeof(msg)), 1);
+
+  BOOST_CHECK_EQUAL(MessageBuffer_nextLength(&Msg), sizeof(msg));
+  BOOST_CHECK_EQUAL(MessageBuffer_free(&Msg),
+                    Len - Prefix - (int)sizeof(msg) - Prefix);
+  BOOST_CHECK_EQUAL(Fifo_used(&Msg.Fifo), Prefix + (int)sizeof(msg));
+
+  BOOST_CHECK_EQUAL(MessageBuffer_read(&Msg, x, sizeof(x)), sizeof(msg));
+  BOOST_CHECK_EQUAL(x, msg);
+
+  BOOST_CHECK_EQUAL(MessageBuffer_nextLength(&Msg), 0);
+  BOOST_CHECK_EQUAL(Fifo_used(&Msg.Fifo), 0);
+}
+
+BOOST_AUTO_TEST_CASE(write_read_wrapping) {
+  uint8_t x[Len], y[Len];
+
+  /* Lengths not multiple of the buffer length, records wrap around. */
+  for (int i = 0; i < 50; ++i) {
+    const len_t length = (len_t)(1 + i % 11);
+
+    for (int j = 0; j < length; ++j)
+      x[j] = (uint8_t)(i + j);
+
+    BOOST_CHECK_EQUAL(MessageBuffer_write(&Msg, x, length), 1);
+    BOOST_CHECK_EQUAL(MessageBuffer_nextLength(&Msg), length);
+    BOOST_CHECK_EQUAL(MessageBuffer_read(&Msg, y, sizeof(y)), length);
+    BOOST_CHECK_EQUAL_COLLECTIONS(&y[0], &y[length], &x[0], &x[length]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(write_read_in_order) {
+  uint8_t x;
+
+  BOOST_CHECK_EQUAL(fill(3), Len / (Prefix + 3));
+
+  for (int i = 0; MessageBuffer_nextLength(&Msg) != 0; ++i) {
+    uint8_t y[3];
+    BOOST_CHECK_EQUAL(MessageBuffer_read(&Msg, y, sizeof(y)), 3);
+    BOOST_CHECK_EQUAL(y[0], i);
+  }
+
+  BOOST_CHECK_EQUAL(MessageBuffer_read(&Msg, &x, 1), 0);
+}
+
+BOOST_AUTO_TEST_CASE(write_does_not_fit) {
+  const int n = fill(5);
+  const len_t used = Fifo_used(&Msg.Fifo);
+  uint8_t x[Len] = {0};
+
+  BOOST_CHECK_EQUAL(n, Len / (Prefix + 5));
+  BOOST_CHECK_LT(MessageBuffer_free(&Msg), 5);
+
+  /* Nothing is written, not even part of the message. */
+  BOOST_CHECK_EQUAL(MessageBuffer_write(&Msg, x, 5), 0);
+  BOOST_CHECK_EQUAL(Fifo_used(&Msg.Fifo), used);
+
+  /* A smaller message still fits. */
+  if (MessageBuffer_free(&Msg) > 0)
+    BOOST_CHECK_EQUAL(MessageBuffer_write(&Msg, x, MessageBuffer_free(&Msg)),
+                      1);
+}
+
+BOOST_AUTO_TEST_CASE(write_invalid_length) {
+  uint8_t x[Len + 1] = {0};
+
+  BOOST_CHECK_EQUAL(MessageBuffer_write(&Msg, x, 0), 0);
+  BOOST_CHECK_EQUAL(MessageBuffer_write(&Msg, x, (len_t)(Len - Prefix + 1)),
+                    0);
+  BOOST_CHECK_EQUAL(Fifo_used(&Msg.Fifo), 0);
+
+  BOOST_CHECK_EQUAL(MessageBuffer_write(&Msg, x, (len_t)(Len - Prefix)), 1);
+  BOOST_CHECK_EQUAL(MessageBuffer_free(&Msg), 0);
+}
+
+BOOST_AUTO_TEST_CASE(read_buffer_too_small) {
+  const char msg[] = "message";
+  char x[Len];
+
+  MessageBuffer_write(&Msg, msg, sizeof(msg));
+
+  /* The message is kept. */
+  BOOST_CHECK_EQUAL(MessageBuffer_read(&Msg, x, sizeof(msg) - 1), 0);
+  BOOST_CHECK_EQUAL(MessageBuffer_nextLength(&Msg), sizeof(msg));
+
+  BOOST_CHECK_EQUAL(MessageBuffer_read(&Msg, x, sizeof(msg)), sizeof(msg));
+  BOOST_CHECK_EQUAL(x, msg);
+}
+
+struct MessageBuffer_t *msgToWrite = NULL;
+struct MessageBuffer_t *msgToRead = NULL;
+
+void write_to_msg(void) {
+  const uint8_t x[3] = {2, 2, 2};
+  librertos_test_set_concurrent_behavior(0);
+
+  /* Outer write is not complete yet. */
+  BOOST_CHECK_EQUAL(MessageBuffer_nextLength(msgToWrite), 0);
+
+  BOOST_CHECK_EQUAL(MessageBuffer_write(msgToWrite, x, sizeof(x)), 1);
+}
+
+BOOST_AUTO_TEST_CASE(write_concurrent) {
+  const uint8_t x[5] = {1, 1, 1, 1, 1};
+  uint8_t y[Len];
+
+  librertos_test_set_concurrent_behavior(&write_to_msg);
+  msgToWrite = &Msg;
+
+  BOOST_CHECK_EQUAL(MessageBuffer_write(&Msg, x, sizeof(x)), 1);
+
+  msgToWrite = NULL;
+  librertos_test_set_concurrent_behavior(0);
+
+  /* Both messages complete, the first reserved first. */
+  BOOST_CHECK_EQUAL(MessageBuffer_read(&Msg, y, sizeof(y)), 5);
+  BOOST_CHECK_EQUAL(y[0], 1);
+  BOOST_CHECK_EQUAL(y[4], 1);
+  BOOST_CHECK_EQUAL(MessageBuffer_read(&Msg, y, sizeof(y)), 3);
+  BOOST_CHECK_EQUAL(y[0], 2);
+  BOOST_CHECK_EQUAL(y[2], 2);
+}
+
+void read_from_msg(void) {
+  uint8_t y[8];
+  librertos_test_set_concurrent_behavior(0);
+
+  BOOST_CHECK_EQUAL(MessageBuffer_read(msgToRead, y, sizeof(y)), 3);
+  BOOST_CHECK_EQUAL(y[0], 2);
+}
+
+BOOST_AUTO_TEST_CASE(read_concurrent) {
+  const uint8_t x1[5] = {1, 1, 1, 1, 1};
+  const uint8_t x2[3] = {2, 2, 2};
+  uint8_t y[Len];
+
+  MessageBuffer_write(&Msg, x1, sizeof(x1));
+  MessageBuffer_write(&Msg, x2, sizeof(x2));
+
+  librertos_test_set_concurrent_behavior(&read_from_msg);
+  msgToRead = &Msg;
+
+  BOOST_CHECK_EQUAL(MessageBuffer_read(&Msg, y, sizeof(y)), 5);
+  BOOST_CHECK_EQUAL(y[0], 1);
+
+  msgToRead = NULL;
+  librertos_test_set_concurrent_behavior(0);
+
+  BOOST_CHECK_EQUAL(MessageBuffer_nextLength(&Msg), 0);
+}
+
+BOOST_AUTO_TEST_CASE(pendread_0_tick) {
+  const tick_t ticksToWait = 0;
+
+  setCurrentTask(&Task1);
+  MessageBuffer_pendRead(&Msg, ticksToWait);
+
+  BOOST_CHECK_EQUAL(Task1.NodeEvent.List, (void *)0);
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.List, (void *)0);
+  BOOST_CHECK_EQUAL(Msg.Fifo.Event.ListRead.Length, 0);
+}
+
+BOOST_AUTO_TEST_CASE(pendread_1_tick) {
+  const tick_t ticksToWait = 1;
+
+  setCurrentTask(&Task1);
+  MessageBuffer_pendRead(&Msg, ticksToWait);
+
+  BOOST_CHECK_EQUAL(Task1.NodeEvent.List, &Msg.Fifo.Event.ListRead);
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.List, &OSstate.BlockedTaskList1);
+  BOOST_CHECK_EQUAL(Msg.Fifo.Event.ListRead.Length, 1);
+}
+
+BOOST_AUTO_TEST_CASE(pendread_on_not_empty_buffer) {
+  const tick_t ticksToWait = 1;
+  const uint8_t x = 0;
+
+  MessageBuffer_write(&Msg, &x, 1);
+
+  setCurrentTask(&Task1);
+  MessageBuffer_pendRead(&Msg, ticksToWait);
+
+  BOOST_CHECK_EQUAL(Task1.NodeEvent.List, (void *)0);
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.List, (void *)0);
+  BOOST_CHECK_EQUAL(Msg.Fifo.Event.ListRead.Length, 0);
+}
+
+BOOST_AUTO_TEST_CASE(write_unblock_task) {
+  const tick_t ticksToWait = 1;
+  const uint8_t x[4] = {0};
+
+  setCurrentTask(&Task1);
+  MessageBuffer_pendRead(&Msg, ticksToWait);
+
+  BOOST_CHECK_EQUAL(Msg.Fifo.Event.ListRead.Length, 1);
+
+  BOOST_CHECK_EQUAL(MessageBuffer_write(&Msg, x, sizeof(x)), 1);
+
+  BOOST_CHECK_EQUAL(Task1.NodeEvent.List, (void *)0);
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.List, (void *)0);
+  BOOST_CHECK_EQUAL(Msg.Fifo.Event.ListRead.Length, 0);
+}
+
+BOOST_AUTO_TEST_CASE(write_not_written_does_not_unblock_task) {
+  const tick_t ticksToWait = 1;
+  const uint8_t x[Len] = {0};
+
+  setCurrentTask(&Task1);
+  MessageBuffer_pendRead(&Msg, ticksToWait);
+
+  BOOST_CHECK_EQUAL(MessageBuffer_write(&Msg, x, sizeof(x)), 0);
+
+  BOOST_CHECK_EQUAL(Task1.NodeEvent.List, &Msg.Fifo.Event.ListRead);
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.List, &OSstate.BlockedTaskList1);
+  BOOST_CHECK_EQUAL(Msg.Fifo.Event.ListRead.Length, 1);
+}
+
+BOOST_AUTO_TEST_CASE(pendwrite_0_tick) {
+  const tick_t ticksToWait = 0;
+
+  fill(5);
+
+  setCurrentTask(&Task1);
+  MessageBuffer_pendWrite(&Msg, 5, ticksToWait);
+
+  BOOST_CHECK_EQUAL(Task1.NodeEvent.List, (void *)0);
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.List, (void *)0);
+  BOOST_CHECK_EQUAL(Msg.Fifo.Event.ListWrite.Length, 0);
+}
+
+BOOST_AUTO_TEST_CASE(pendwrite_1_tick) {
+  const tick_t ticksToWait = 1;
+
+  fill(5);
+
+  setCurrentTask(&Task1);
+  MessageBuffer_pendWrite(&Msg, 5, ticksToWait);
+
+  BOOST_CHECK_EQUAL(Task1.NodeEvent.List, &Msg.Fifo.Event.ListWrite);
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.List, &OSstate.BlockedTaskList1);
+  BOOST_CHECK_EQUAL(Msg.Fifo.Event.ListWrite.Length, 1);
+}
+
+BOOST_AUTO_TEST_CASE(pendwrite_on_enough_space) {
+  const tick_t ticksToWait = 1;
+
+  setCurrentTask(&Task1);
+  MessageBuffer_pendWrite(&Msg, 5, ticksToWait);
+
+  BOOST_CHECK_EQUAL(Task1.NodeEvent.List, (void *)0);
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.List, (void *)0);
+  BOOST_CHECK_EQUAL(Msg.Fifo.Event.ListWrite.Length, 0);
+}
+
+BOOST_AUTO_TEST_CASE(read_unblock_task_whole_message) {
+  const tick_t ticksToWait = 1;
+  const len_t length = 10;
+  uint8_t y[Len];
+
+  /* Records of 2 + 2 bytes. */
+  fill(2);
+
+  setCurrentTask(&Task1);
+  MessageBuffer_pendWrite(&Msg, length, ticksToWait);
+
+  BOOST_CHECK_EQUAL(Msg.Fifo.Event.ListWrite.Length, 1);
+
+  /* Still not enough space for length bytes and their prefix. */
+  for (int i = 0; (i + 1) * (Prefix + 2) < Prefix + length; ++i) {
+    BOOST_CHECK_EQUAL(MessageBuffer_read(&Msg, y, sizeof(y)), 2);
+
+    BOOST_CHECK_EQUAL(Task1.NodeEvent.List, &Msg.Fifo.Event.ListWrite);
+    BOOST_CHECK_EQUAL(Msg.Fifo.Event.ListWrite.Length, 1);
+  }
+
+  BOOST_CHECK_EQUAL(MessageBuffer_read(&Msg, y, sizeof(y)), 2);
+
+  BOOST_CHECK_GE(MessageBuffer_free(&Msg), length);
+  BOOST_CHECK_EQUAL(Task1.NodeEvent.List, (void *)0);
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.List, (void *)0);
+  BOOST_CHECK_EQUAL(Msg.Fifo.Event.ListWrite.Length, 0);
+}
+
+BOOST_AUTO_TEST_CASE(readpend_1_tick) {
+  const tick_t ticksToWait = 1;
+  uint8_t y[Len];
+
+  setCurrentTask(&Task1);
+  BOOST_CHECK_EQUAL(MessageBuffer_readPend(&Msg, y, sizeof(y), ticksToWait),
+                    0);
+
+  BOOST_CHECK_EQUAL(Task1.NodeEvent.List, &Msg.Fifo.Event.ListRead);
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.List, &OSstate.BlockedTaskList1);
+  BOOST_CHECK_EQUAL(Msg.Fifo.Event.ListRead.Length, 1);
+}
+
+BOOST_AUTO_TEST_CASE(readpend_on_not_empty_buffer) {
+  const tick_t ticksToWait = 1;
+  const uint8_t x[2] = {7, 8};
+  uint8_t y[Len];
+
+  MessageBuffer_write(&Msg, x, sizeof(x));
+
+  setCurrentTask(&Task1);
+  BOOST_CHECK_EQUAL(MessageBuffer_readPend(&Msg, y, sizeof(y), ticksToWait),
+                    2);
+  BOOST_CHECK_EQUAL(y[1], 8);
+
+  BOOST_CHECK_EQUAL(Task1.NodeEvent.List, (void *)0);
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.List, (void *)0);
+  BOOST_CHECK_EQUAL(Msg.Fifo.Event.ListRead.Length, 0);
+}
+
+BOOST_AUTO_TEST_CASE(writepend_1_tick) {
+  const tick_t ticksToWait = 1;
+  const uint8_t x[5] = {0};
+
+  fill(5);
+
+  setCurrentTask(&Task1);
+  BOOST_CHECK_EQUAL(
+      MessageBuffer_writePend(&Msg, x, sizeof(x), ticksToWait), 0);
+
+  BOOST_CHECK_EQUAL(Task1.NodeEvent.List, &Msg.Fifo.Event.ListWrite);
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.List, &OSstate.BlockedTaskList1);
+  BOOST_CHECK_EQUAL(Msg.Fifo.Event.ListWrite.Length, 1);
+}
+
+BOOST_AUTO_TEST_CASE(writepend_on_enough_space) {
+  const tick_t ticksToWait = 1;
+  const uint8_t x[5] = {0};
+
+  setCurrentTask(&Task1);
+  BOOST_CHECK_EQUAL(
+      MessageBuffer_writePend(&Msg, x, sizeof(x), ticksToWait), 1);
+
+  BOOST_CHECK_EQUAL(Task1.NodeEvent.List, (void *)0);
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.List, (void *)0);
+  BOOST_CHECK_EQUAL(Msg.Fifo.Event.ListWrite.Length, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -27,10 +27,12 @@ BOOST_AUTO_TEST_CASE(init_unlocked) {
   BOOST_CHECK_EQUAL(Mtx.MutexOwner, (void *)0);
 
   /* Event struct */
+#if (LIBRERTOS_COMPACT_LISTS == 0)
   const struct taskListNode_t *nodeHead =
       (struct taskListNode_t *)&Mtx.Event.ListRead;
   BOOST_CHECK_EQUAL(Mtx.Event.ListRead.Head, nodeHead);
   BOOST_CHECK_EQUAL(Mtx.Event.ListRead.Tail, nodeHead);
+#endif
   BOOST_CHECK_EQUAL(Mtx.Event.ListRead.Length, 0);
 }
 
@@ -0,0 +1,300 @@
+#include "LibreRTOS.h"
+#include "TheHeader.h"
+#include <boost/test/unit_test.hpp>
+
+#if (LIBRERTOS_NOTIFICATIONS != 0)
+
+/* Built with direct task notifications enabled:
+ scripts/run_config_tests.sh "-DLIBRERTOS_NOTIFICATIONS=1" \
+     tests/test_Notify.cpp */
+
+struct NotifyFixture {
+  struct task_t Task;
+  struct task_t Task2;
+
+  NotifyFixture() {
+    OS_init();
+    OS_start();
+
+    OS_taskCreate(&Task, 0, NULL, NULL);
+  }
+  ~NotifyFixture() { BOOST_CHECK_EQUAL(OSstate.SchedulerLock, 0); }
+};
+
+BOOST_FIXTURE_TEST_SUITE(Notify, NotifyFixture)
+
+BOOST_AUTO_TEST_CASE(init) {
+  BOOST_CHECK_EQUAL(Task.NotifyValue, 0);
+  BOOST_CHECK_EQUAL(Task.NotifyPending, 0);
+}
+
+BOOST_AUTO_TEST_CASE(notify_setbits) {
+  OS_taskNotify(&Task, 0x01, NOTIFY_SETBITS);
+  OS_taskNotify(&Task, 0x10, NOTIFY_SETBITS);
+
+  BOOST_CHECK_EQUAL(Task.NotifyValue, 0x11);
+  BOOST_CHECK_EQUAL(Task.NotifyPending, 1);
+}
+
+BOOST_AUTO_TEST_CASE(notify_increment) {
+  OS_taskNotify(&Task, 0, NOTIFY_INCREMENT);
+  OS_taskNotify(&Task, 0, NOTIFY_INCREMENT);
+  OS_taskNotify(&Task, 0, NOTIFY_INCREMENT);
+
+  BOOST_CHECK_EQUAL(Task.NotifyValue, 3);
+  BOOST_CHECK_EQUAL(Task.NotifyPending, 1);
+}
+
+BOOST_AUTO_TEST_CASE(notify_overwrite) {
+  OS_taskNotify(&Task, 0x0F, NOTIFY_SETBITS);
+  OS_taskNotify(&Task, 0x30, NOTIFY_OVERWRITE);
+
+  BOOST_CHECK_EQUAL(Task.NotifyValue, 0x30);
+  BOOST_CHECK_EQUAL(Task.NotifyPending, 1);
+}
+
+BOOST_AUTO_TEST_CASE(notify_null_task) {
+  BOOST_CHECK_THROW(OS_taskNotify(NULL, 1, NOTIFY_SETBITS), int);
+}
+
+BOOST_AUTO_TEST_CASE(take_not_pending) {
+  notify_t value = 0xAA;
+
+  setCurrentTask(&Task);
+  BOOST_CHECK_EQUAL(OS_taskNotifyTake(&value, ~(notify_t)0), 0);
+
+  /* Value not written. */
+  BOOST_CHECK_EQUAL(value, 0xAA);
+}
+
+BOOST_AUTO_TEST_CASE(take_clear_all) {
+  notify_t value = 0;
+
+  OS_taskNotify(&Task, 0x81, NOTIFY_SETBITS);
+
+  setCurrentTask(&Task);
+  BOOST_CHECK_EQUAL(OS_taskNotifyTake(&value, ~(notify_t)0), 1);
+
+  BOOST_CHECK_EQUAL(value, 0x81);
+  BOOST_CHECK_EQUAL(Task.NotifyValue, 0);
+  BOOST_CHECK_EQUAL(Task.NotifyPending, 0);
+
+  BOOST_CHECK_EQUAL(OS_taskNotifyTake(&value, ~(notify_t)0), 0);
+}
+
+BOOST_AUTO_TEST_CASE(take_clear_some_bits) {
+  notify_t value = 0;
+
+  OS_taskNotify(&Task, 0x81, NOTIFY_SETBITS);
+
+  setCurrentTask(&Task);
+  BOOST_CHECK_EQUAL(OS_taskNotifyTake(&value, 0x01), 1);
+
+  /* Value before clearing. Not pending, even with bits left set. */
+  BOOST_CHECK_EQUAL(value, 0x81);
+  BOOST_CHECK_EQUAL(Task.NotifyValue, 0x80);
+  BOOST_CHECK_EQUAL(Task.NotifyPending, 0);
+
+  OS_taskNotify(&Task, 0x02, NOTIFY_SETBITS);
+
+  BOOST_CHECK_EQUAL(OS_taskNotifyTake(&value, ~(notify_t)0), 1);
+  BOOST_CHECK_EQUAL(value, 0x82);
+}
+
+BOOST_AUTO_TEST_CASE(take_null_value) {
+  OS_taskNotify(&Task, 1, NOTIFY_INCREMENT);
+
+  setCurrentTask(&Task);
+  BOOST_CHECK_EQUAL(OS_taskNotifyTake(NULL, ~(notify_t)0), 1);
+  BOOST_CHECK_EQUAL(Task.NotifyPending, 0);
+}
+
+BOOST_AUTO_TEST_CASE(pend_0_tick) {
+  const tick_t ticksToWait = 0;
+
+  setCurrentTask(&Task);
+  OS_taskNotifyPend(ticksToWait);
+
+  BOOST_CHECK_EQUAL(Task.State, TASKSTATE_READY);
+  BOOST_CHECK_EQUAL(Task.NodeEvent.List, (void *)0);
+  BOOST_CHECK_EQUAL(Task.NodeDelay.List, (void *)0);
+}
+
+BOOST_AUTO_TEST_CASE(pend_1_tick) {
+  const tick_t ticksToWait = 1;
+
+  setCurrentTask(&Task);
+  OS_taskNotifyPend(ticksToWait);
+
+  /* Blocked without an event list. */
+  BOOST_CHECK_EQUAL(Task.State, TASKSTATE_BLOCKED);
+  BOOST_CHECK_EQUAL(Task.NodeEvent.List, (void *)0);
+  BOOST_CHECK_EQUAL(Task.NodeDelay.List, &OSstate.BlockedTaskList1);
+}
+
+BOOST_AUTO_TEST_CASE(pend_on_pending_notification) {
+  const tick_t ticksToWait = 1;
+
+  OS_taskNotify(&Task, 1, NOTIFY_SETBITS);
+
+  setCurrentTask(&Task);
+  OS_taskNotifyPend(ticksToWait);
+
+  BOOST_CHECK_EQUAL(Task.State, TASKSTATE_READY);
+  BOOST_CHECK_EQUAL(Task.NodeDelay.List, (void *)0);
+}
+
+BOOST_AUTO_TEST_CASE(notify_unblock_task) {
+  const tick_t ticksToWait = 1;
+  notify_t value = 0;
+
+  setCurrentTask(&Task);
+  OS_taskNotifyPend(ticksToWait);
+  setCurrentTask(NULL);
+
+  OS_taskNotify(&Task, 0x05, NOTIFY_OVERWRITE);
+
+  BOOST_CHECK_EQUAL(Task.State, TASKSTATE_READY);
+  BOOST_CHECK_EQUAL(Task.NodeEvent.List, (void *)0);
+  BOOST_CHECK_EQUAL(Task.NodeDelay.List, (void *)0);
+  BOOST_CHECK_EQUAL(OSstate.BlockedTaskList1.Length, 0);
+
+  setCurrentTask(&Task);
+  BOOST_CHECK_EQUAL(OS_taskNotifyTake(&value, ~(notify_t)0), 1);
+  BOOST_CHECK_EQUAL(value, 0x05);
+}
+
+BOOST_AUTO_TEST_CASE(notify_unblock_once) {
+  setCurrentTask(&Task);
+  OS_taskNotifyPend(MAX_DELAY);
+  setCurrentTask(NULL);
+
+  OS_taskNotify(&Task, 0, NOTIFY_INCREMENT);
+  OS_taskNotify(&Task, 0, NOTIFY_INCREMENT);
+
+  BOOST_CHECK_EQUAL(Task.State, TASKSTATE_READY);
+  BOOST_CHECK_EQUAL(Task.NotifyValue, 2);
+}
+
+BOOST_AUTO_TEST_CASE(notify_delayed_task_not_unblocked) {
+  setCurrentTask(&Task);
+  OS_taskDelay(5);
+  setCurrentTask(NULL);
+
+  OS_taskNotify(&Task, 1, NOTIFY_SETBITS);
+
+  /* Only a task waiting for a notification is unblocked. */
+  BOOST_CHECK_EQUAL(Task.State, TASKSTATE_BLOCKED);
+  BOOST_CHECK_EQUAL(Task.NodeDelay.List, &OSstate.BlockedTaskList1);
+  BOOST_CHECK_EQUAL(Task.NotifyPending, 1);
+}
+
+BOOST_AUTO_TEST_CASE(notify_other_task) {
+  OS_taskCreate(&Task2, 1, NULL, NULL);
+
+  setCurrentTask(&Task);
+  OS_taskNotifyPend(MAX_DELAY);
+  setCurrentTask(NULL);
+
+  OS_taskNotify(&Task2, 1, NOTIFY_SETBITS);
+
+  BOOST_CHECK_EQUAL(Task.State, TASKSTATE_BLOCKED);
+  BOOST_CHECK_EQUAL(Task.NotifyPending, 0);
+  BOOST_CHECK_EQUAL(Task2.NotifyPending, 1);
+}
+
+BOOST_AUTO_TEST_CASE(pend_timeout) {
+  const tick_t ticksToWait = 1;
+
+  setCurrentTask(&Task);
+  OS_taskNotifyPend(ticksToWait);
+  setCurrentTask(NULL);
+
+  OS_tick();
+  OS_schedulerLock();
+  OS_schedulerUnlock();
+
+  BOOST_CHECK_EQUAL(Task.State, TASKSTATE_READY);
+  BOOST_CHECK_EQUAL(Task.NodeDelay.List, (void *)0);
+
+  setCurrentTask(&Task);
+  BOOST_CHECK_EQUAL(OS_taskNotifyTake(NULL, ~(notify_t)0), 0);
+}
+
+BOOST_AUTO_TEST_CASE(takepend_pending) {
+  const tick_t ticksToWait = 1;
+  notify_t value = 0;
+
+  OS_taskNotify(&Task, 3, NOTIFY_OVERWRITE);
+
+  setCurrentTask(&Task);
+  BOOST_CHECK_EQUAL(
+      OS_taskNotifyTakePend(&value, ~(notify_t)0, ticksToWait), 1);
+
+  BOOST_CHECK_EQUAL(value, 3);
+  BOOST_CHECK_EQUAL(Task.State, TASKSTATE_READY);
+  BOOST_CHECK_EQUAL(Task.NodeDelay.List, (void *)0);
+}
+
+BOOST_AUTO_TEST_CASE(takepend_1_tick) {
+  const tick_t ticksToWait = 1;
+  notify_t value = 0;
+
+  setCurrentTask(&Task);
+  BOOST_CHECK_EQUAL(
+      OS_taskNotifyTakePend(&value, ~(notify_t)0, ticksToWait), 0);
+
+  BOOST_CHECK_EQUAL(Task.State, TASKSTATE_BLOCKED);
+  BOOST_CHECK_EQUAL(Task.NodeDelay.List, &OSstate.BlockedTaskList1);
+}
+
+BOOST_AUTO_TEST_CASE(notify_in_interrupt) {
+  setCurrentTask(&Task);
+  OS_taskNotifyPend(MAX_DELAY);
+  setCurrentTask(NULL);
+
+  OS_interruptEnter();
+  OS_taskNotify(&Task, 1, NOTIFY_SETBITS);
+  OS_interruptExit();
+
+  /* Only moved to the pending ready list by the interrupt. */
+  BOOST_CHECK_EQUAL(Task.State, TASKSTATE_BLOCKED);
+  BOOST_CHECK_EQUAL(Task.NodeEvent.List, &OSstate.PendingReadyTaskList);
+  BOOST_CHECK_EQUAL(Task.NotifyPending, 1);
+
+  OS_schedulerLock();
+  OS_schedulerUnlock();
+
+  BOOST_CHECK_EQUAL(Task.State, TASKSTATE_READY);
+  BOOST_CHECK_EQUAL(Task.NodeEvent.List, (void *)0);
+  BOOST_CHECK_EQUAL(Task.NodeDelay.List, (void *)0);
+}
+
+static struct task_t *notifyConcurrentTask;
+
+void notify_concurrent(void) {
+  librertos_test_set_concurrent_behavior(0);
+  OS_taskNotify(notifyConcurrentTask, 0x10, NOTIFY_SETBITS);
+}
+
+BOOST_AUTO_TEST_CASE(pend_concurrent_notify) {
+  notifyConcurrentTask = &Task;
+  librertos_test_set_concurrent_behavior(&notify_concurrent);
+
+  setCurrentTask(&Task);
+  OS_taskNotifyPend(MAX_DELAY);
+
+  librertos_test_set_concurrent_behavior(0);
+
+  /* A notification while pending is never missed. */
+  OS_schedulerLock();
+  OS_schedulerUnlock();
+
+  BOOST_CHECK_EQUAL(Task.State, TASKSTATE_READY);
+  BOOST_CHECK_EQUAL(Task.NodeDelay.List, (void *)0);
+  BOOST_CHECK_EQUAL(Task.NotifyPending, 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif /* LIBRERTOS_NOTIFICATIONS */
@@ -18,10 +18,8 @@ BOOST_AUTO_TEST_CASE(initialize_eventR) {
 
   OS_eventRInit(&event);
 
-  BOOST_CHECK_EQUAL(event.ListRead.Head,
-                    (struct taskListNode_t *)&event.ListRead);
-  BOOST_CHECK_EQUAL(event.ListRead.Tail,
-                    (struct taskListNode_t *)&event.ListRead);
+  BOOST_CHECK_EQUAL(event.ListRead.Head, listEnd(&event.ListRead));
+  BOOST_CHECK_EQUAL(event.ListRead.Tail, listEnd(&event.ListRead));
   BOOST_CHECK_EQUAL(event.ListRead.Length, 0);
 }
 
@@ -30,16 +28,12 @@ BOOST_AUTO_TEST_CASE(initialize_eventRw) {
 
   OS_eventRwInit(&event);
 
-  BOOST_CHECK_EQUAL(event.ListRead.Head,
-                    (struct taskListNode_t *)&event.ListRead);
-  BOOST_CHECK_EQUAL(event.ListRead.Tail,
-                    (struct taskListNode_t *)&event.ListRead);
+  BOOST_CHECK_EQUAL(event.ListRead.Head, listEnd(&event.ListRead));
+  BOOST_CHECK_EQUAL(event.ListRead.Tail, listEnd(&event.ListRead));
   BOOST_CHECK_EQUAL(event.ListRead.Length, 0);
 
-  BOOST_CHECK_EQUAL(event.ListWrite.Head,
-                    (struct taskListNode_t *)&event.ListWrite);
-  BOOST_CHECK_EQUAL(event.ListWrite.Tail,
-                    (struct taskListNode_t *)&event.ListWrite);
+  BOOST_CHECK_EQUAL(event.ListWrite.Head, listEnd(&event.ListWrite));
+  BOOST_CHECK_EQUAL(event.ListWrite.Tail, listEnd(&event.ListWrite));
   BOOST_CHECK_EQUAL(event.ListWrite.Length, 0);
 }
 
@@ -56,8 +50,8 @@ BOOST_AUTO_TEST_CASE(prepend_task) {
 
   BOOST_CHECK_EQUAL(task->NodeEvent.List, &event.ListRead);
 
-  BOOST_CHECK_EQUAL(event.ListRead.Head, &task->NodeEvent);
-  BOOST_CHECK_EQUAL(event.ListRead.Tail, &task->NodeEvent);
+  BOOST_CHECK_EQUAL(event.ListRead.Head, eventNode(task));
+  BOOST_CHECK_EQUAL(event.ListRead.Tail, eventNode(task));
   BOOST_CHECK_EQUAL(event.ListRead.Length, 1);
 }
 
@@ -78,8 +72,8 @@ BOOST_AUTO_TEST_CASE(prepend_task_after_first_pended_task) {
 
   BOOST_CHECK_EQUAL(task1->NodeEvent.List, &event.ListRead);
 
-  BOOST_CHECK_EQUAL(event.ListRead.Head, &task1->NodeEvent);
-  BOOST_CHECK_EQUAL(event.ListRead.Tail, &task1->NodeEvent);
+  BOOST_CHECK_EQUAL(event.ListRead.Head, eventNode(task1));
+  BOOST_CHECK_EQUAL(event.ListRead.Tail, eventNode(task1));
   BOOST_CHECK_EQUAL(event.ListRead.Length, 1);
 
   struct task_t *task2 = &theTask2;
@@ -89,8 +83,8 @@ BOOST_AUTO_TEST_CASE(prepend_task_after_first_pended_task) {
 
   BOOST_CHECK_EQUAL(task2->NodeEvent.List, &event.ListRead);
 
-  BOOST_CHECK_EQUAL(event.ListRead.Head, &task2->NodeEvent);
-  BOOST_CHECK_EQUAL(event.ListRead.Tail, &task1->NodeEvent);
+  BOOST_CHECK_EQUAL(event.ListRead.Head, eventNode(task2));
+  BOOST_CHECK_EQUAL(event.ListRead.Tail, eventNode(task1));
   BOOST_CHECK_EQUAL(event.ListRead.Length, 2);
 }
 
@@ -110,8 +104,8 @@ BOOST_AUTO_TEST_CASE(pend_task_suspend) {
 
   BOOST_CHECK_EQUAL(task->NodeEvent.List, &event.ListRead);
 
-  BOOST_CHECK_EQUAL(event.ListRead.Head, &task->NodeEvent);
-  BOOST_CHECK_EQUAL(event.ListRead.Tail, &task->NodeEvent);
+  BOOST_CHECK_EQUAL(event.ListRead.Head, eventNode(task));
+  BOOST_CHECK_EQUAL(event.ListRead.Tail, eventNode(task));
   BOOST_CHECK_EQUAL(event.ListRead.Length, 1);
 }
 
@@ -131,8 +125,8 @@ BOOST_AUTO_TEST_CASE(pend_task_block) {
 
   BOOST_CHECK_EQUAL(task->NodeEvent.List, &event.ListRead);
 
-  BOOST_CHECK_EQUAL(event.ListRead.Head, &task->NodeEvent);
-  BOOST_CHECK_EQUAL(event.ListRead.Tail, &task->NodeEvent);
+  BOOST_CHECK_EQUAL(event.ListRead.Head, eventNode(task));
+  BOOST_CHECK_EQUAL(event.ListRead.Tail, eventNode(task));
   BOOST_CHECK_EQUAL(event.ListRead.Length, 1);
 }
 
@@ -153,8 +147,8 @@ BOOST_AUTO_TEST_CASE(pend_task_after_first_pended_task) {
 
   BOOST_CHECK_EQUAL(task1->NodeEvent.List, &event.ListRead);
 
-  BOOST_CHECK_EQUAL(event.ListRead.Head, &task1->NodeEvent);
-  BOOST_CHECK_EQUAL(event.ListRead.Tail, &task1->NodeEvent);
+  BOOST_CHECK_EQUAL(event.ListRead.Head, eventNode(task1));
+  BOOST_CHECK_EQUAL(event.ListRead.Tail, eventNode(task1));
   BOOST_CHECK_EQUAL(event.ListRead.Length, 1);
 
   struct task_t *task2 = &theTask2;
@@ -167,8 +161,8 @@ BOOST_AUTO_TEST_CASE(pend_task_after_first_pended_task) {
 
   BOOST_CHECK_EQUAL(task2->NodeEvent.List, &event.ListRead);
 
-  BOOST_CHECK_EQUAL(event.ListRead.Head, &task1->NodeEvent);
-  BOOST_CHECK_EQUAL(event.ListRead.Tail, &task2->NodeEvent);
+  BOOST_CHECK_EQUAL(event.ListRead.Head, eventNode(task1));
+  BOOST_CHECK_EQUAL(event.ListRead.Tail, eventNode(task2));
   BOOST_CHECK_EQUAL(event.ListRead.Length, 2);
 
   BOOST_CHECK_LT(priority1, priority2);
@@ -192,8 +186,8 @@ BOOST_AUTO_TEST_CASE(pend_task_between_tow_pended_task) {
 
   BOOST_CHECK_EQUAL(task1->NodeEvent.List, &event.ListRead);
 
-  BOOST_CHECK_EQUAL(event.ListRead.Head, &task1->NodeEvent);
-  BOOST_CHECK_EQUAL(event.ListRead.Tail, &task1->NodeEvent);
+  BOOST_CHECK_EQUAL(event.ListRead.Head, eventNode(task1));
+  BOOST_CHECK_EQUAL(event.ListRead.Tail, eventNode(task1));
   BOOST_CHECK_EQUAL(event.ListRead.Length, 1);
 
   struct task_t *task2 = &theTask2;
@@ -206,8 +200,8 @@ BOOST_AUTO_TEST_CASE(pend_task_between_tow_pended_task) {
 
   BOOST_CHECK_EQUAL(task2->NodeEvent.List, &event.ListRead);
 
-  BOOST_CHECK_EQUAL(event.ListRead.Head, &task1->NodeEvent);
-  BOOST_CHECK_EQUAL(event.ListRead.Tail, &task2->NodeEvent);
+  BOOST_CHECK_EQUAL(event.ListRead.Head, eventNode(task1));
+  BOOST_CHECK_EQUAL(event.ListRead.Tail, eventNode(task2));
   BOOST_CHECK_EQUAL(event.ListRead.Length, 2);
 
   struct task_t *task3 = &theTask3;
@@ -220,9 +214,13 @@ BOOST_AUTO_TEST_CASE(pend_task_between_tow_pended_task) {
 
   BOOST_CHECK_EQUAL(task3->NodeEvent.List, &event.ListRead);
 
-  BOOST_CHECK_EQUAL(event.ListRead.Head, &task1->NodeEvent);
+  BOOST_CHECK_EQUAL(event.ListRead.Head, eventNode(task1));
+#if (LIBRERTOS_COMPACT_LISTS == 0)
   BOOST_CHECK_EQUAL(event.ListRead.Head->Next, &task3->NodeEvent);
-  BOOST_CHECK_EQUAL(event.ListRead.Tail, &task2->NodeEvent);
+#else
+  BOOST_CHECK_EQUAL(OS_listNode(event.ListRead.Head)->Next, eventNode(task3));
+#endif
+  BOOST_CHECK_EQUAL(event.ListRead.Tail, eventNode(task2));
   BOOST_CHECK_EQUAL(event.ListRead.Length, 3);
 
   BOOST_CHECK_LT(priority1, priority2);
@@ -247,8 +245,8 @@ BOOST_AUTO_TEST_CASE(pend_task_before_first_pended_task) {
 
   BOOST_CHECK_EQUAL(task1->NodeEvent.List, &event.ListRead);
 
-  BOOST_CHECK_EQUAL(event.ListRead.Head, &task1->NodeEvent);
-  BOOST_CHECK_EQUAL(event.ListRead.Tail, &task1->NodeEvent);
+  BOOST_CHECK_EQUAL(event.ListRead.Head, eventNode(task1));
+  BOOST_CHECK_EQUAL(event.ListRead.Tail, eventNode(task1));
   BOOST_CHECK_EQUAL(event.ListRead.Length, 1);
 
   struct task_t *task2 = &theTask2;
@@ -261,8 +259,8 @@ BOOST_AUTO_TEST_CASE(pend_task_before_first_pended_task) {
 
   BOOST_CHECK_EQUAL(task2->NodeEvent.List, &event.ListRead);
 
-  BOOST_CHECK_EQUAL(event.ListRead.Head, &task2->NodeEvent);
-  BOOST_CHECK_EQUAL(event.ListRead.Tail, &task1->NodeEvent);
+  BOOST_CHECK_EQUAL(event.ListRead.Head, eventNode(task2));
+  BOOST_CHECK_EQUAL(event.ListRead.Tail, eventNode(task1));
   BOOST_CHECK_EQUAL(event.ListRead.Length, 2);
 
   BOOST_CHECK_GT(priority1, priority2);
@@ -295,8 +293,8 @@ BOOST_AUTO_TEST_CASE(unblock_task_of_higher_priority) {
   BOOST_CHECK_EQUAL(task1->NodeEvent.List, &event.ListRead);
   BOOST_CHECK_EQUAL(task2->NodeEvent.List, &OSstate.PendingReadyTaskList);
 
-  BOOST_CHECK_EQUAL(event.ListRead.Head, &task1->NodeEvent);
-  BOOST_CHECK_EQUAL(event.ListRead.Tail, &task1->NodeEvent);
+  BOOST_CHECK_EQUAL(event.ListRead.Head, eventNode(task1));
+  BOOST_CHECK_EQUAL(event.ListRead.Tail, eventNode(task1));
   BOOST_CHECK_EQUAL(event.ListRead.Length, 1);
 
   OS_eventUnblockTasks(&event.ListRead);
@@ -304,10 +302,8 @@ BOOST_AUTO_TEST_CASE(unblock_task_of_higher_priority) {
   BOOST_CHECK_EQUAL(task1->NodeEvent.List, &OSstate.PendingReadyTaskList);
   BOOST_CHECK_EQUAL(task2->NodeEvent.List, &OSstate.PendingReadyTaskList);
 
-  BOOST_CHECK_EQUAL(event.ListRead.Head,
-                    (struct taskListNode_t *)&event.ListRead);
-  BOOST_CHECK_EQUAL(event.ListRead.Tail,
-                    (struct taskListNode_t *)&event.ListRead);
+  BOOST_CHECK_EQUAL(event.ListRead.Head, listEnd(&event.ListRead));
+  BOOST_CHECK_EQUAL(event.ListRead.Tail, listEnd(&event.ListRead));
   BOOST_CHECK_EQUAL(event.ListRead.Length, 0);
 
   BOOST_CHECK_LT(priority1, priority2);
@@ -337,8 +333,8 @@ BOOST_AUTO_TEST_CASE(task_unblocked_before_pending) {
 
   BOOST_CHECK_EQUAL(task->NodeEvent.List, &OSstate.PendingReadyTaskList);
 
-  BOOST_CHECK_EQUAL(event.ListRead.Head, (void *)&event.ListRead);
-  BOOST_CHECK_EQUAL(event.ListRead.Tail, (void *)&event.ListRead);
+  BOOST_CHECK_EQUAL(event.ListRead.Head, listEnd(&event.ListRead));
+  BOOST_CHECK_EQUAL(event.ListRead.Tail, listEnd(&event.ListRead));
   BOOST_CHECK_EQUAL(event.ListRead.Length, 0);
 }
 
@@ -372,8 +368,8 @@ BOOST_AUTO_TEST_CASE(task_unblocked_while_pending) {
 
   BOOST_CHECK_EQUAL(task->NodeEvent.List, &OSstate.PendingReadyTaskList);
 
-  BOOST_CHECK_EQUAL(event.ListRead.Head, (void *)&event.ListRead);
-  BOOST_CHECK_EQUAL(event.ListRead.Tail, (void *)&event.ListRead);
+  BOOST_CHECK_EQUAL(event.ListRead.Head, listEnd(&event.ListRead));
+  BOOST_CHECK_EQUAL(event.ListRead.Tail, listEnd(&event.ListRead));
   BOOST_CHECK_EQUAL(event.ListRead.Length, 0);
 }
 
@@ -408,8 +404,8 @@ BOOST_AUTO_TEST_CASE(task_on_pos_unblocked_while_pending) {
   BOOST_CHECK_EQUAL(task1->NodeEvent.List, &OSstate.PendingReadyTaskList);
   BOOST_CHECK_EQUAL(task2->NodeEvent.List, &event.ListRead);
 
-  BOOST_CHECK_EQUAL(event.ListRead.Head, &task2->NodeEvent);
-  BOOST_CHECK_EQUAL(event.ListRead.Tail, &task2->NodeEvent);
+  BOOST_CHECK_EQUAL(event.ListRead.Head, eventNode(task2));
+  BOOST_CHECK_EQUAL(event.ListRead.Tail, eventNode(task2));
   BOOST_CHECK_EQUAL(event.ListRead.Length, 1);
 
   BOOST_CHECK_LT(priority2, priority1);
@@ -2,6 +2,11 @@
 #include "OSlist.h"
 #include <boost/test/unit_test.hpp>
 
+#if (LIBRERTOS_COMPACT_LISTS == 0)
+
+/* Pointer linked lists. The index linked layout is tested in
+ test_OSlistCompact.cpp. */
+
 BOOST_AUTO_TEST_SUITE(OSlist)
 
 BOOST_AUTO_TEST_CASE(initialize_list_head) {
@@ -186,3 +191,5 @@ BOOST_AUTO_TEST_CASE(insert_prioritized_nodes_to_list) {
 }
 
 BOOST_AUTO_TEST_SUITE_END()
+
+#endif /* LIBRERTOS_COMPACT_LISTS */
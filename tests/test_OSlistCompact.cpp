@@ -0,0 +1,232 @@
+#include "LibreRTOS.h"
+#include "OSlist.h"
+#include "TheHeader.h"
+#include <boost/test/unit_test.hpp>
+
+#if (LIBRERTOS_COMPACT_LISTS != 0)
+
+/* Compact lists link the nodes with 8 or 16-bit indices. Index LIST_END ends
+ a list. The nodes are addressed through the kernel object tables (tasks by
+ priority, timers by slot) and the owner is derived from the node position,
+ so it is not stored. Built with the full suite:
+ scripts/run_config_tests.sh "-DLIBRERTOS_COMPACT_LISTS=8" */
+
+struct OSlistCompactFixture {
+  struct task_t Task1, Task2, Task3;
+
+  OSlistCompactFixture() {
+    OS_init();
+    OS_start();
+
+    OS_taskCreate(&Task1, 1, (taskFunction_t)NULL, NULL);
+    OS_taskCreate(&Task2, 2, (taskFunction_t)NULL, NULL);
+    OS_taskCreate(&Task3, 3, (taskFunction_t)NULL, NULL);
+  }
+  ~OSlistCompactFixture() { BOOST_CHECK_EQUAL(OSstate.SchedulerLock, 0); }
+};
+
+/* Layout of the pointer linked node. */
+struct pointerListNode_t {
+  void *Next;
+  void *Previous;
+  tick_t Value;
+  void *List;
+  void *Owner;
+};
+
+static void timerFunction(struct Timer_t *, void *) {}
+
+BOOST_FIXTURE_TEST_SUITE(OSlistCompact, OSlistCompactFixture)
+
+BOOST_AUTO_TEST_CASE(index_width) {
+  BOOST_CHECK_EQUAL(sizeof(listIndex_t) * 8, LIBRERTOS_COMPACT_LISTS);
+  BOOST_CHECK_EQUAL(LIST_END, (listIndex_t)-1);
+
+  /* All nodes must be addressable. */
+  BOOST_CHECK_LT(LIST_INDEX_TIMER(LIBRERTOS_MAX_TIMERS - 1), LIST_END);
+}
+
+BOOST_AUTO_TEST_CASE(node_is_smaller) {
+  BOOST_CHECK_LT(sizeof(struct taskListNode_t),
+                 sizeof(struct pointerListNode_t));
+  /* List pointer, value and two indices, plus padding. */
+  BOOST_CHECK_LE(sizeof(struct taskListNode_t),
+                 sizeof(void *) + sizeof(tick_t) + 2 * sizeof(listIndex_t) +
+                     sizeof(void *) - 1);
+}
+
+BOOST_AUTO_TEST_CASE(initialize_list_head) {
+  struct taskHeadList_t list;
+
+  OS_listHeadInit(&list);
+
+  BOOST_CHECK_EQUAL(list.Head, LIST_END);
+  BOOST_CHECK_EQUAL(list.Tail, LIST_END);
+  BOOST_CHECK_EQUAL(list.Length, 0);
+}
+
+BOOST_AUTO_TEST_CASE(initialize_list_node) {
+  struct taskListNode_t node;
+
+  OS_listNodeInit(&node);
+
+  BOOST_CHECK_EQUAL(node.Next, LIST_END);
+  BOOST_CHECK_EQUAL(node.Previous, LIST_END);
+  BOOST_CHECK_EQUAL(node.Value, 0);
+  BOOST_CHECK_EQUAL(node.List, (struct taskHeadList_t *)NULL);
+}
+
+BOOST_AUTO_TEST_CASE(task_nodes_and_owner) {
+  BOOST_CHECK_EQUAL(OS_listNode(LIST_INDEX_DELAY(1)), &Task1.NodeDelay);
+  BOOST_CHECK_EQUAL(OS_listNode(LIST_INDEX_EVENT(1)), &Task1.NodeEvent);
+  BOOST_CHECK_EQUAL(OS_listNode(LIST_INDEX_DELAY(3)), &Task3.NodeDelay);
+  BOOST_CHECK_EQUAL(OS_listNode(LIST_INDEX_EVENT(3)), &Task3.NodeEvent);
+
+  BOOST_CHECK_EQUAL(OS_listOwner(LIST_INDEX_DELAY(1)), &Task1);
+  BOOST_CHECK_EQUAL(OS_listOwner(LIST_INDEX_EVENT(1)), &Task1);
+  BOOST_CHECK_EQUAL(OS_listOwner(LIST_INDEX_DELAY(2)), &Task2);
+  BOOST_CHECK_EQUAL(OS_listOwner(LIST_INDEX_EVENT(2)), &Task2);
+}
+
+BOOST_AUTO_TEST_CASE(insert_and_remove_nodes_from_list) {
+  struct taskHeadList_t list;
+  const listIndex_t index1 = LIST_INDEX_DELAY(1);
+  const listIndex_t index2 = LIST_INDEX_DELAY(2);
+  const listIndex_t index3 = LIST_INDEX_DELAY(3);
+
+  OS_listHeadInit(&list);
+
+  /* LIST_END position inserts at the head. */
+  OS_listInsertAfter(&list, list.Head, index1);
+  OS_listInsertAfter(&list, list.Head, index3);
+  OS_listInsertAfter(&list, Task3.NodeDelay.Previous, index2);
+
+  /* node1 */
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.Next, index2);
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.Previous, LIST_END);
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.List, &list);
+
+  /* node2 */
+  BOOST_CHECK_EQUAL(Task2.NodeDelay.Next, index3);
+  BOOST_CHECK_EQUAL(Task2.NodeDelay.Previous, index1);
+  BOOST_CHECK_EQUAL(Task2.NodeDelay.List, &list);
+
+  /* node3 */
+  BOOST_CHECK_EQUAL(Task3.NodeDelay.Next, LIST_END);
+  BOOST_CHECK_EQUAL(Task3.NodeDelay.Previous, index2);
+  BOOST_CHECK_EQUAL(Task3.NodeDelay.List, &list);
+
+  /* list */
+  BOOST_CHECK_EQUAL(list.Head, index1);
+  BOOST_CHECK_EQUAL(list.Tail, index3);
+  BOOST_CHECK_EQUAL(list.Length, 3);
+
+  OS_listRemove(index2);
+
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.Next, index3);
+  BOOST_CHECK_EQUAL(Task3.NodeDelay.Previous, index1);
+  BOOST_CHECK_EQUAL(Task2.NodeDelay.Next, LIST_END);
+  BOOST_CHECK_EQUAL(Task2.NodeDelay.Previous, LIST_END);
+  BOOST_CHECK_EQUAL(Task2.NodeDelay.List, (struct taskHeadList_t *)NULL);
+  BOOST_CHECK_EQUAL(list.Length, 2);
+
+  OS_listRemove(index3);
+  OS_listRemove(index1);
+
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.List, (struct taskHeadList_t *)NULL);
+  BOOST_CHECK_EQUAL(Task3.NodeDelay.List, (struct taskHeadList_t *)NULL);
+
+  BOOST_CHECK_EQUAL(list.Head, LIST_END);
+  BOOST_CHECK_EQUAL(list.Tail, LIST_END);
+  BOOST_CHECK_EQUAL(list.Length, 0);
+}
+
+BOOST_AUTO_TEST_CASE(delay_task_insertion_order) {
+  setCurrentTask(&Task1);
+  OS_taskDelay(1);
+  setCurrentTask(&Task2);
+  OS_taskDelay(3);
+  setCurrentTask(&Task3);
+  OS_taskDelay(2);
+
+  struct taskHeadList_t *list = blockedTaskList();
+
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.List, list);
+  BOOST_CHECK_EQUAL(Task2.NodeDelay.List, list);
+  BOOST_CHECK_EQUAL(Task3.NodeDelay.List, list);
+
+  BOOST_CHECK_EQUAL(OS_listOwner(list->Head), &Task1);
+  BOOST_CHECK_EQUAL(OS_listOwner(OS_listNode(list->Head)->Next), &Task3);
+  BOOST_CHECK_EQUAL(OS_listOwner(list->Tail), &Task2);
+  BOOST_CHECK_EQUAL(list->Length, 3);
+
+  OS_taskResume(&Task3);
+
+  BOOST_CHECK_EQUAL(Task3.NodeDelay.List, (struct taskHeadList_t *)NULL);
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.Next, LIST_INDEX_DELAY(2));
+  BOOST_CHECK_EQUAL(list->Length, 2);
+
+  OS_scheduler();
+}
+
+BOOST_AUTO_TEST_CASE(pend_on_event) {
+  struct Semaphore_t Sem;
+
+  Semaphore_init(&Sem, 0, 1);
+
+  setCurrentTask(&Task1);
+  Semaphore_pend(&Sem, 1);
+  setCurrentTask(&Task3);
+  Semaphore_pend(&Sem, 1);
+
+  BOOST_CHECK_EQUAL(Task1.NodeEvent.List, &Sem.Event.ListRead);
+  BOOST_CHECK_EQUAL(Task3.NodeEvent.List, &Sem.Event.ListRead);
+  BOOST_CHECK_EQUAL(Sem.Event.ListRead.Length, 2);
+
+  /* Ordered by priority, the tail is unblocked first. */
+  BOOST_CHECK_EQUAL(OS_listOwner(Sem.Event.ListRead.Head), &Task1);
+  BOOST_CHECK_EQUAL(OS_listOwner(Sem.Event.ListRead.Tail), &Task3);
+
+  Semaphore_give(&Sem);
+
+  BOOST_CHECK_EQUAL(Task3.NodeEvent.List, (struct taskHeadList_t *)NULL);
+  BOOST_CHECK_EQUAL(Sem.Event.ListRead.Head, LIST_INDEX_EVENT(1));
+  BOOST_CHECK_EQUAL(Sem.Event.ListRead.Length, 1);
+
+  OS_scheduler();
+}
+
+BOOST_AUTO_TEST_CASE(timer_slots) {
+  struct Timer_t Timer1, Timer2;
+
+  Timer_init(&Timer1, TIMERTYPE_ONESHOT, 1, &timerFunction, NULL);
+  Timer_init(&Timer2, TIMERTYPE_ONESHOT, 2, &timerFunction, NULL);
+
+  BOOST_CHECK_EQUAL(OSstate.Timer[0], &Timer1);
+  BOOST_CHECK_EQUAL(OSstate.Timer[1], &Timer2);
+
+  BOOST_CHECK_EQUAL(OS_listNode(LIST_INDEX_TIMER(0)), &Timer1.NodeTimer);
+  BOOST_CHECK_EQUAL(OS_listOwner(LIST_INDEX_TIMER(0)), &Timer1);
+  BOOST_CHECK_EQUAL(OS_listOwner(LIST_INDEX_TIMER(1)), &Timer2);
+
+  /* Started timers are staged in the unordered list. */
+  Timer_start(&Timer2);
+
+  BOOST_CHECK_EQUAL(Timer2.NodeTimer.List, &OSstate.TimerUnorderedList);
+  BOOST_CHECK_EQUAL(OSstate.TimerUnorderedList.Head, LIST_INDEX_TIMER(1));
+}
+
+BOOST_AUTO_TEST_CASE(timer_table_full) {
+  struct Timer_t Timers[LIBRERTOS_MAX_TIMERS + 1];
+
+  for (int i = 0; i < LIBRERTOS_MAX_TIMERS; ++i)
+    Timer_init(&Timers[i], TIMERTYPE_ONESHOT, 1, &timerFunction, NULL);
+
+  BOOST_CHECK_THROW(Timer_init(&Timers[LIBRERTOS_MAX_TIMERS],
+                               TIMERTYPE_ONESHOT, 1, &timerFunction, NULL),
+                    int);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif /* LIBRERTOS_COMPACT_LISTS */
@@ -0,0 +1,233 @@
+#include "LibreRTOS.h"
+#include "Objects.h"
+#include "TheHeader.h"
+#include <boost/test/unit_test.hpp>
+
+struct ObjectsFixture {
+  struct task_t Task1;
+  struct task_t Task2;
+
+  ObjectsFixture() {
+    OS_init();
+    OS_start();
+
+    OS_taskCreate(&Task1, 0, NULL, NULL);
+    OS_taskCreate(&Task2, 1, NULL, NULL);
+  }
+  ~ObjectsFixture() { BOOST_CHECK_EQUAL(OSstate.SchedulerLock, 0); }
+
+  static void timerFunction(struct Timer_t *, void *) {}
+};
+
+struct Message {
+  uint16_t Id;
+  uint32_t Value;
+};
+
+BOOST_FIXTURE_TEST_SUITE(Objects, ObjectsFixture)
+
+BOOST_AUTO_TEST_CASE(fifo) {
+  librertos::Fifo<16> fif;
+  const uint8_t data[] = {1, 2, 3};
+  uint8_t buff[3] = {0};
+
+  BOOST_CHECK_EQUAL(fif.length(), 16);
+  BOOST_CHECK_EQUAL(Fifo_length(fif.get()), 16);
+  BOOST_CHECK_EQUAL(fif.free(), 16);
+
+  BOOST_CHECK_EQUAL(fif.write(&data[0], 3), 3);
+  BOOST_CHECK_EQUAL(fif.used(), 3);
+
+  BOOST_CHECK_EQUAL(fif.read(&buff[0], 3), 3);
+  BOOST_CHECK_EQUAL(buff[0], 1);
+  BOOST_CHECK_EQUAL(buff[2], 3);
+  BOOST_CHECK_EQUAL(fif.used(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(fifo_pend_read) {
+  librertos::Fifo<4> fif;
+  uint8_t x;
+
+  setCurrentTask(&Task1);
+  BOOST_CHECK_EQUAL(fif.readPend(&x, 1, 1), 0);
+
+  BOOST_CHECK_EQUAL(Task1.NodeEvent.List, &fif.get()->Event.ListRead);
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.List, &OSstate.BlockedTaskList1);
+}
+
+BOOST_AUTO_TEST_CASE(queue) {
+  librertos::Queue<Message, 3> que;
+  Message msg = {0, 0};
+
+  BOOST_CHECK_EQUAL(que.length(), 3);
+  BOOST_CHECK_EQUAL(que.itemSize(), (len_t)sizeof(Message));
+  BOOST_CHECK_EQUAL(Queue_itemSize(que.get()), (len_t)sizeof(Message));
+
+  for (uint16_t i = 0; i < 3; ++i) {
+    msg.Id = i;
+    msg.Value = 100u * i;
+    BOOST_CHECK_EQUAL(que.write(msg), true);
+  }
+
+  BOOST_CHECK_EQUAL(que.write(msg), false);
+  BOOST_CHECK_EQUAL(que.used(), 3);
+  BOOST_CHECK_EQUAL(que.free(), 0);
+
+  for (uint16_t i = 0; i < 3; ++i) {
+    BOOST_CHECK_EQUAL(que.read(msg), true);
+    BOOST_CHECK_EQUAL(msg.Id, i);
+    BOOST_CHECK_EQUAL(msg.Value, 100u * i);
+  }
+
+  BOOST_CHECK_EQUAL(que.read(msg), false);
+}
+
+BOOST_AUTO_TEST_CASE(queue_pend) {
+  librertos::Queue<uint32_t, 2> que;
+  uint32_t x = 5;
+
+  setCurrentTask(&Task1);
+  BOOST_CHECK_EQUAL(que.readPend(x, 1), false);
+
+  BOOST_CHECK_EQUAL(Task1.NodeEvent.List, &que.get()->Event.ListRead);
+
+  setCurrentTask(NULL);
+  BOOST_CHECK_EQUAL(que.write(x), true);
+
+  BOOST_CHECK_EQUAL(Task1.NodeEvent.List, (void *)0);
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.List, (void *)0);
+}
+
+BOOST_AUTO_TEST_CASE(semaphore) {
+  librertos::Semaphore<2> sem(1);
+
+  BOOST_CHECK_EQUAL(sem.max(), 2);
+  BOOST_CHECK_EQUAL(Semaphore_getMax(sem.get()), 2);
+  BOOST_CHECK_EQUAL(sem.count(), 1);
+
+  BOOST_CHECK_EQUAL(sem.give(), true);
+  BOOST_CHECK_EQUAL(sem.give(), false);
+  BOOST_CHECK_EQUAL(sem.count(), 2);
+
+  BOOST_CHECK_EQUAL(sem.take(), true);
+  BOOST_CHECK_EQUAL(sem.take(), true);
+  BOOST_CHECK_EQUAL(sem.take(), false);
+}
+
+BOOST_AUTO_TEST_CASE(semaphore_pend) {
+  librertos::Semaphore<1> sem;
+
+  setCurrentTask(&Task1);
+  BOOST_CHECK_EQUAL(sem.takePend(1), false);
+
+  BOOST_CHECK_EQUAL(Task1.NodeEvent.List, &sem.get()->Event.ListRead);
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.List, &OSstate.BlockedTaskList1);
+}
+
+BOOST_AUTO_TEST_CASE(mutex) {
+  librertos::Mutex mtx;
+
+  setCurrentTask(&Task1);
+  BOOST_CHECK_EQUAL(mtx.lock(), true);
+  BOOST_CHECK_EQUAL(mtx.owner(), &Task1);
+  BOOST_CHECK_EQUAL(mtx.count(), 1);
+
+  setCurrentTask(&Task2);
+  BOOST_CHECK_EQUAL(mtx.lock(), false);
+
+  setCurrentTask(&Task1);
+  BOOST_CHECK_EQUAL(mtx.unlock(), true);
+  BOOST_CHECK_EQUAL(mtx.owner(), (void *)0);
+}
+
+BOOST_AUTO_TEST_CASE(mutex_lock_scope) {
+  librertos::Mutex mtx;
+
+  setCurrentTask(&Task1);
+  {
+    librertos::MutexLock lock(mtx);
+
+    BOOST_CHECK_EQUAL(lock.locked(), true);
+    BOOST_CHECK_EQUAL(mtx.owner(), &Task1);
+  }
+
+  BOOST_CHECK_EQUAL(mtx.owner(), (void *)0);
+  BOOST_CHECK_EQUAL(mtx.count(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(mutex_lock_scope_not_locked) {
+  librertos::Mutex mtx;
+
+  setCurrentTask(&Task1);
+  mtx.lock();
+
+  setCurrentTask(&Task2);
+  {
+    librertos::MutexLock lock(mtx, 1);
+
+    /* Pended, the mutex of the other task is not unlocked. */
+    BOOST_CHECK_EQUAL(lock.locked(), false);
+    BOOST_CHECK_EQUAL(Task2.NodeEvent.List, &mtx.get()->Event.ListRead);
+  }
+
+  BOOST_CHECK_EQUAL(mtx.owner(), &Task1);
+  BOOST_CHECK_EQUAL(mtx.count(), 1);
+}
+
+#if (LIBRERTOS_SOFTWARETIMERS != 0)
+BOOST_AUTO_TEST_CASE(timer) {
+  OS_timerTaskCreate(2);
+
+  librertos::Timer timer(TIMERTYPE_AUTO, 5, &timerFunction, (void *)1);
+
+  BOOST_CHECK_EQUAL(timer.get()->Period, 5);
+  BOOST_CHECK_EQUAL(timer.isRunning(), false);
+
+  timer.start();
+  BOOST_CHECK_EQUAL(timer.isRunning(), true);
+
+  timer.stop();
+  BOOST_CHECK_EQUAL(timer.isRunning(), false);
+}
+
+BOOST_AUTO_TEST_CASE(timer_stopped_out_of_scope) {
+  OS_timerTaskCreate(2);
+
+  struct Timer_t *tmr;
+  {
+    librertos::Timer timer(TIMERTYPE_ONESHOT, 5, &timerFunction, NULL);
+    tmr = timer.get();
+    timer.start();
+    BOOST_CHECK_EQUAL(OSstate.TimerUnorderedList.Length, 1);
+  }
+
+  /* Not left in the timer lists, to be run after its storage is gone. */
+  BOOST_CHECK_EQUAL(OSstate.TimerUnorderedList.Length, 0);
+  BOOST_CHECK_EQUAL(OSstate.TimerList.Length, 0);
+
+#if (LIBRERTOS_COMPACT_LISTS != 0)
+  for (int i = 0; i < LIBRERTOS_MAX_TIMERS; ++i)
+    BOOST_CHECK_NE(OSstate.Timer[i], tmr);
+
+  /* Slots are released, more timers than slots fit one after another. */
+  for (int i = 0; i <= LIBRERTOS_MAX_TIMERS; ++i) {
+    librertos::Timer timer(TIMERTYPE_ONESHOT, 5, &timerFunction, NULL);
+    timer.start();
+  }
+  BOOST_CHECK_EQUAL(OSstate.TimerUnorderedList.Length, 0);
+#else
+  (void)tmr;
+#endif
+}
+#endif
+
+BOOST_AUTO_TEST_CASE(storage_in_object) {
+  /* No pointer or size kept outside of the C object and its buffer. */
+  BOOST_CHECK_EQUAL(sizeof(librertos::Fifo<16>),
+                    sizeof(struct Fifo_t) + 16);
+  BOOST_CHECK_EQUAL(sizeof(librertos::Semaphore<3>),
+                    sizeof(struct Semaphore_t));
+  BOOST_CHECK_EQUAL(sizeof(librertos::Mutex), sizeof(struct Mutex_t));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
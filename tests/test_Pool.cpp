@@ -0,0 +1,256 @@
+#include "LibreRTOS.h"
+#include "TheHeader.h"
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+#include <set>
+
+typedef uint64_t PoolType;
+
+struct PoolFixture {
+  static const int BlockWords = 2;
+  static const int NumBlocks = 4;
+  static const PoolType PoolGuard = 0xFA57C0DEFA57C0DE;
+
+  const len_t BlockSize = BlockWords * (len_t)sizeof(PoolType);
+
+  /* Buffer with guards at begin and end. */
+  const PoolType Guard = PoolGuard;
+  PoolType PoolBuff_WithGuards[BlockWords * NumBlocks + 2];
+
+  struct Pool_t Pool;
+  uint8_t *PoolBuff = (uint8_t *)&PoolBuff_WithGuards[1];
+
+  struct task_t Task;
+
+  PoolFixture() {
+    OS_init();
+    OS_start();
+
+    PoolBuff_WithGuards[0] = Guard;
+    PoolBuff_WithGuards[BlockWords * NumBlocks + 1] = Guard;
+
+    Pool_init(&Pool, &PoolBuff[0], BlockSize, NumBlocks);
+
+    OS_taskCreate(&Task, 0, NULL, NULL);
+  }
+  ~PoolFixture() {
+    BOOST_CHECK_EQUAL(OSstate.SchedulerLock, 0);
+
+    /* Constants after initialization. */
+    BOOST_CHECK_EQUAL(Pool_length(&Pool), NumBlocks);
+    BOOST_CHECK_EQUAL(Pool_blockSize(&Pool), BlockSize);
+    BOOST_CHECK_EQUAL(Pool.Buff, (void *)&PoolBuff[0]);
+
+    /* Check overflow guards. */
+    BOOST_CHECK_EQUAL(PoolBuff_WithGuards[0], Guard);
+    BOOST_CHECK_EQUAL(PoolBuff_WithGuards[BlockWords * NumBlocks + 1], Guard);
+  }
+
+  /* Allocated block must be a block of the buffer. */
+  void checkBlock(void *block) {
+    const uint8_t *p = (const uint8_t *)block;
+    BOOST_CHECK(p >= &PoolBuff[0]);
+    BOOST_CHECK(p < &PoolBuff[BlockSize * NumBlocks]);
+    BOOST_CHECK_EQUAL((p - &PoolBuff[0]) % BlockSize, 0);
+  }
+};
+
+const int PoolFixture::NumBlocks;
+
+BOOST_FIXTURE_TEST_SUITE(Pool, PoolFixture)
+
+BOOST_AUTO_TEST_CASE(init) {
+  BOOST_CHECK_EQUAL(Pool_used(&Pool), 0);
+  BOOST_CHECK_EQUAL(Pool_maxUsed(&Pool), 0);
+
+#if (LIBRERTOS_COMPACT_LISTS == 0)
+  const struct taskListNode_t *nodeHead =
+      (struct taskListNode_t *)&Pool.Event.ListRead;
+  BOOST_CHECK_EQUAL(Pool.Event.ListRead.Head, nodeHead);
+  BOOST_CHECK_EQUAL(Pool.Event.ListRead.Tail, nodeHead);
+#endif
+  BOOST_CHECK_EQUAL(Pool.Event.ListRead.Length, 0);
+}
+
+BOOST_AUTO_TEST_CASE(init_block_too_small) {
+  struct Pool_t pool;
+
+  /* The free list is embedded in the free blocks. */
+  BOOST_CHECK_THROW(
+      Pool_init(&pool, &PoolBuff[0], (len_t)(sizeof(void *) - 1), NumBlocks),
+      int);
+}
+
+BOOST_AUTO_TEST_CASE(alloc_in_buffer_order) {
+  for (int i = 0; i < NumBlocks; ++i) {
+    void *block = Pool_alloc(&Pool);
+
+    BOOST_CHECK_EQUAL(block, (void *)&PoolBuff[i * BlockSize]);
+    BOOST_CHECK_EQUAL(Pool_used(&Pool), i + 1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(alloc_all_blocks) {
+  std::set<void *> blocks;
+
+  for (int i = 0; i < NumBlocks; ++i) {
+    void *block = Pool_alloc(&Pool);
+
+    BOOST_REQUIRE(block != NULL);
+    checkBlock(block);
+    blocks.insert(block);
+
+    /* Blocks do not overlap. */
+    std::memset(block, 0xA0 + i, BlockSize);
+  }
+
+  BOOST_CHECK_EQUAL(blocks.size(), (size_t)NumBlocks);
+  BOOST_CHECK_EQUAL(Pool_alloc(&Pool), (void *)NULL);
+  BOOST_CHECK_EQUAL(Pool_used(&Pool), NumBlocks);
+  BOOST_CHECK_EQUAL(Pool_maxUsed(&Pool), NumBlocks);
+
+  for (int i = 0; i < NumBlocks; ++i)
+    for (int j = 0; j < BlockSize; ++j)
+      BOOST_CHECK_EQUAL(PoolBuff[i * BlockSize + j], 0xA0 + i);
+}
+
+BOOST_AUTO_TEST_CASE(free_last_freed_first) {
+  void *block1 = Pool_alloc(&Pool);
+  void *block2 = Pool_alloc(&Pool);
+
+  Pool_free(&Pool, block1);
+  Pool_free(&Pool, block2);
+
+  BOOST_CHECK_EQUAL(Pool_used(&Pool), 0);
+
+  BOOST_CHECK_EQUAL(Pool_alloc(&Pool), block2);
+  BOOST_CHECK_EQUAL(Pool_alloc(&Pool), block1);
+}
+
+BOOST_AUTO_TEST_CASE(free_all_and_alloc_again) {
+  void *blocks[NumBlocks];
+
+  for (int i = 0; i < NumBlocks; ++i)
+    blocks[i] = Pool_alloc(&Pool);
+  for (int i = 0; i < NumBlocks; ++i)
+    Pool_free(&Pool, blocks[i]);
+
+  BOOST_CHECK_EQUAL(Pool_used(&Pool), 0);
+
+  for (int i = 0; i < NumBlocks; ++i)
+    checkBlock(Pool_alloc(&Pool));
+
+  BOOST_CHECK_EQUAL(Pool_alloc(&Pool), (void *)NULL);
+}
+
+BOOST_AUTO_TEST_CASE(max_used) {
+  void *block1 = Pool_alloc(&Pool);
+  void *block2 = Pool_alloc(&Pool);
+  Pool_alloc(&Pool);
+
+  Pool_free(&Pool, block1);
+  Pool_free(&Pool, block2);
+  Pool_alloc(&Pool);
+
+  BOOST_CHECK_EQUAL(Pool_used(&Pool), 2);
+  BOOST_CHECK_EQUAL(Pool_maxUsed(&Pool), 3);
+}
+
+BOOST_AUTO_TEST_CASE(free_invalid_block) {
+  uint8_t *block = (uint8_t *)Pool_alloc(&Pool);
+
+  /* Outside of the buffer. */
+  BOOST_CHECK_THROW(Pool_free(&Pool, &PoolBuff[NumBlocks * BlockSize]), int);
+  BOOST_CHECK_THROW(Pool_free(&Pool, &PoolBuff[-1]), int);
+
+  /* Not at the start of a block. */
+  BOOST_CHECK_THROW(Pool_free(&Pool, block + 1), int);
+
+  BOOST_CHECK_EQUAL(Pool_used(&Pool), 1);
+}
+
+BOOST_AUTO_TEST_CASE(pend_0_tick) {
+  const tick_t ticksToWait = 0;
+
+  while (Pool_alloc(&Pool) != NULL) {
+  }
+
+  setCurrentTask(&Task);
+  Pool_pend(&Pool, ticksToWait);
+
+  BOOST_CHECK_EQUAL(Task.NodeEvent.List, (void *)0);
+  BOOST_CHECK_EQUAL(Task.NodeDelay.List, (void *)0);
+  BOOST_CHECK_EQUAL(Pool.Event.ListRead.Length, 0);
+}
+
+BOOST_AUTO_TEST_CASE(pend_1_tick) {
+  const tick_t ticksToWait = 1;
+
+  while (Pool_alloc(&Pool) != NULL) {
+  }
+
+  setCurrentTask(&Task);
+  Pool_pend(&Pool, ticksToWait);
+
+  BOOST_CHECK_EQUAL(Task.NodeEvent.List, &Pool.Event.ListRead);
+  BOOST_CHECK_EQUAL(Task.NodeDelay.List, &OSstate.BlockedTaskList1);
+  BOOST_CHECK_EQUAL(Pool.Event.ListRead.Length, 1);
+}
+
+BOOST_AUTO_TEST_CASE(pend_on_available_block) {
+  const tick_t ticksToWait = 1;
+
+  setCurrentTask(&Task);
+  Pool_pend(&Pool, ticksToWait);
+
+  BOOST_CHECK_EQUAL(Task.NodeEvent.List, (void *)0);
+  BOOST_CHECK_EQUAL(Task.NodeDelay.List, (void *)0);
+  BOOST_CHECK_EQUAL(Pool.Event.ListRead.Length, 0);
+}
+
+BOOST_AUTO_TEST_CASE(free_unblock_task) {
+  const tick_t ticksToWait = 1;
+  void *block = Pool_alloc(&Pool);
+
+  while (Pool_alloc(&Pool) != NULL) {
+  }
+
+  setCurrentTask(&Task);
+  Pool_pend(&Pool, ticksToWait);
+
+  BOOST_CHECK_EQUAL(Pool.Event.ListRead.Length, 1);
+
+  Pool_free(&Pool, block);
+
+  BOOST_CHECK_EQUAL(Task.NodeEvent.List, (void *)0);
+  BOOST_CHECK_EQUAL(Task.NodeDelay.List, (void *)0);
+  BOOST_CHECK_EQUAL(Pool.Event.ListRead.Length, 0);
+}
+
+BOOST_AUTO_TEST_CASE(allocpend_on_available_block) {
+  const tick_t ticksToWait = 1;
+
+  setCurrentTask(&Task);
+  void *block = Pool_allocPend(&Pool, ticksToWait);
+
+  checkBlock(block);
+  BOOST_CHECK_EQUAL(Task.NodeEvent.List, (void *)0);
+  BOOST_CHECK_EQUAL(Task.NodeDelay.List, (void *)0);
+  BOOST_CHECK_EQUAL(Pool.Event.ListRead.Length, 0);
+}
+
+BOOST_AUTO_TEST_CASE(allocpend_1_tick) {
+  const tick_t ticksToWait = 1;
+
+  while (Pool_alloc(&Pool) != NULL) {
+  }
+
+  setCurrentTask(&Task);
+  BOOST_CHECK_EQUAL(Pool_allocPend(&Pool, ticksToWait), (void *)NULL);
+
+  BOOST_CHECK_EQUAL(Task.NodeEvent.List, &Pool.Event.ListRead);
+  BOOST_CHECK_EQUAL(Task.NodeDelay.List, &OSstate.BlockedTaskList1);
+  BOOST_CHECK_EQUAL(Pool.Event.ListRead.Length, 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,199 @@
+#include "LibreRTOS.h"
+#include "OSprofile.h"
+#include "TheHeader.h"
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+#include <string>
+
+#if (LIBRERTOS_PROFILE_CRITICAL != 0)
+
+/* Profiling changes the system run time seen by the other tests, so it is
+ built on its own:
+ scripts/run_config_tests.sh -DLIBRERTOS_PROFILE_CRITICAL=1 \
+     tests/test_Profile.cpp */
+
+struct ProfileFixture {
+  ProfileFixture() {
+    OS_init();
+    OS_start();
+
+    OS_profileClear();
+  }
+  ~ProfileFixture() { BOOST_CHECK_EQUAL(OSstate.SchedulerLock, 0); }
+
+  /* Site of this file at a line, NULL if not recorded. */
+  static const struct OSprofileSite_t *findSite(enum profileKind_t kind,
+                                                int line) {
+    for (len_t i = 0; i < OS_profileSites(kind); ++i) {
+      const struct OSprofileSite_t *site = OS_profileSite(kind, i);
+      if (site->Line == line && std::strcmp(site->File, __FILE__) == 0)
+        return site;
+    }
+    return NULL;
+  }
+
+  static statcount_t histogramSum(const struct OSprofileSite_t *site) {
+    statcount_t sum = 0;
+    for (int i = 0; i < LIBRERTOS_PROFILE_BINS; ++i)
+      sum += site->Histogram[i];
+    return sum;
+  }
+};
+
+static std::string dumpText;
+
+static void dumpWrite(const void *data, len_t length) {
+  dumpText.append((const char *)data, length);
+}
+
+BOOST_FIXTURE_TEST_SUITE(Profile, ProfileFixture)
+
+BOOST_AUTO_TEST_CASE(clear) {
+  BOOST_CHECK_EQUAL(OS_profileSites(PROFILE_CRITICAL), 0);
+  BOOST_CHECK_EQUAL(OS_profileSites(PROFILE_SCHEDULERLOCK), 0);
+  BOOST_CHECK_EQUAL(OS_profileLost(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(critical_section) {
+  CRITICAL_VAL();
+
+  const int line = __LINE__ + 1;
+  CRITICAL_ENTER();
+  librertos_test_add_run_time(5);
+  CRITICAL_EXIT();
+
+  const struct OSprofileSite_t *site = findSite(PROFILE_CRITICAL, line);
+
+  BOOST_REQUIRE(site != NULL);
+  BOOST_CHECK_EQUAL(site->Count, 1);
+  BOOST_CHECK_GE(site->Max, 5);
+  BOOST_CHECK_LT(site->Max, 8);
+  BOOST_CHECK_EQUAL(site->Total, site->Max);
+
+  /* Bin i counts durations in [2^(i-1), 2^i). */
+  BOOST_CHECK_EQUAL(site->Histogram[3], 1);
+  BOOST_CHECK_EQUAL(histogramSum(site), 1);
+}
+
+BOOST_AUTO_TEST_CASE(critical_section_max_and_total) {
+  const stattime_t durations[] = {1, 20, 3};
+  CRITICAL_VAL();
+  int line = 0;
+
+  for (int i = 0; i < 3; ++i) {
+    line = __LINE__ + 1;
+    CRITICAL_ENTER();
+    librertos_test_add_run_time(durations[i]);
+    CRITICAL_EXIT();
+  }
+
+  const struct OSprofileSite_t *site = findSite(PROFILE_CRITICAL, line);
+
+  BOOST_REQUIRE(site != NULL);
+  BOOST_CHECK_EQUAL(site->Count, 3);
+  BOOST_CHECK_GE(site->Max, 20);
+  BOOST_CHECK_LT(site->Max, 23);
+  BOOST_CHECK_GE(site->Total, 24);
+  BOOST_CHECK_EQUAL(histogramSum(site), 3);
+}
+
+BOOST_AUTO_TEST_CASE(nested_critical_section) {
+  CRITICAL_VAL();
+
+  const int outer = __LINE__ + 1;
+  CRITICAL_ENTER();
+  librertos_test_add_run_time(3);
+  const int inner = __LINE__ + 1;
+  CRITICAL_ENTER();
+  librertos_test_add_run_time(3);
+  CRITICAL_EXIT();
+  CRITICAL_EXIT();
+
+  /* Interrupts are enabled again by the outermost exit. */
+  const struct OSprofileSite_t *site = findSite(PROFILE_CRITICAL, outer);
+
+  BOOST_REQUIRE(site != NULL);
+  BOOST_CHECK_GE(site->Max, 6);
+  BOOST_CHECK(findSite(PROFILE_CRITICAL, inner) == NULL);
+}
+
+BOOST_AUTO_TEST_CASE(scheduler_lock) {
+  const int line = __LINE__ + 1;
+  OS_schedulerLock();
+  OS_schedulerLock();
+  librertos_test_add_run_time(10);
+  OS_schedulerUnlock();
+  OS_schedulerUnlock();
+
+  const struct OSprofileSite_t *site = findSite(PROFILE_SCHEDULERLOCK, line);
+
+  BOOST_REQUIRE(site != NULL);
+  BOOST_CHECK_EQUAL(site->Count, 1);
+  BOOST_CHECK_GE(site->Max, 10);
+  BOOST_CHECK(findSite(PROFILE_SCHEDULERLOCK, line + 1) == NULL);
+}
+
+BOOST_AUTO_TEST_CASE(kernel_sites) {
+  struct Semaphore_t sem;
+
+  Semaphore_init(&sem, 0, 1);
+  Semaphore_give(&sem);
+
+  /* The kernel API records its own critical sections. */
+  BOOST_CHECK_GT(OS_profileSites(PROFILE_CRITICAL), 0);
+
+  for (len_t i = 0; i < OS_profileSites(PROFILE_CRITICAL); ++i) {
+    const struct OSprofileSite_t *site = OS_profileSite(PROFILE_CRITICAL, i);
+    BOOST_CHECK(site->File != NULL);
+    BOOST_CHECK_GT(site->Count, 0);
+    BOOST_CHECK_EQUAL(histogramSum(site), site->Count);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(sites_full) {
+  for (int i = 0; i < LIBRERTOS_PROFILE_SITES; ++i) {
+    OS_profileCriticalEnter("site", i);
+    OS_profileCriticalExit();
+  }
+
+  BOOST_CHECK_EQUAL(OS_profileSites(PROFILE_CRITICAL),
+                    LIBRERTOS_PROFILE_SITES);
+  BOOST_CHECK_EQUAL(OS_profileLost(), 0);
+
+  OS_profileCriticalEnter("site", LIBRERTOS_PROFILE_SITES);
+  OS_profileCriticalExit();
+
+  BOOST_CHECK_EQUAL(OS_profileSites(PROFILE_CRITICAL),
+                    LIBRERTOS_PROFILE_SITES);
+  BOOST_CHECK_EQUAL(OS_profileLost(), 1);
+
+  /* Known sites are still recorded. */
+  OS_profileCriticalEnter("site", 0);
+  OS_profileCriticalExit();
+
+  BOOST_CHECK_EQUAL(OS_profileSite(PROFILE_CRITICAL, 0)->Count, 2);
+  BOOST_CHECK_EQUAL(OS_profileLost(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(dump) {
+  CRITICAL_VAL();
+
+  const int line = __LINE__ + 1;
+  CRITICAL_ENTER();
+  CRITICAL_EXIT();
+
+  dumpText.clear();
+  OS_profileDump(&dumpWrite);
+
+  const std::string header = "kind,file,line,count,total,max,";
+  BOOST_CHECK_EQUAL(dumpText.compare(0, header.size(), header), 0);
+
+  std::string site = std::string("critical,") + __FILE__ + "," +
+                     std::to_string(line) + ",1,";
+  BOOST_CHECK(dumpText.find(site) != std::string::npos);
+  BOOST_CHECK_EQUAL(dumpText[dumpText.size() - 1], '\n');
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif /* LIBRERTOS_PROFILE_CRITICAL */
@@ -64,16 +64,20 @@ BOOST_AUTO_TEST_CASE(init) {
   BOOST_CHECK_EQUAL(Que.Buff, (void *)&QueBuff[0]);
   BOOST_CHECK_EQUAL(Que.BufEnd, (void *)&QueBuff[Len - 1]);
 
+#if (LIBRERTOS_COMPACT_LISTS == 0)
   struct taskListNode_t *nodeHead;
 
   nodeHead = (struct taskListNode_t *)&Que.Event.ListRead;
   BOOST_CHECK_EQUAL(Que.Event.ListRead.Head, nodeHead);
   BOOST_CHECK_EQUAL(Que.Event.ListRead.Tail, nodeHead);
+#endif
   BOOST_CHECK_EQUAL(Que.Event.ListRead.Length, 0);
 
+#if (LIBRERTOS_COMPACT_LISTS == 0)
   nodeHead = (struct taskListNode_t *)&Que.Event.ListWrite;
   BOOST_CHECK_EQUAL(Que.Event.ListWrite.Head, nodeHead);
   BOOST_CHECK_EQUAL(Que.Event.ListWrite.Tail, nodeHead);
+#endif
   BOOST_CHECK_EQUAL(Que.Event.ListWrite.Length, 0);
 }
 
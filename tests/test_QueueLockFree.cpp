@@ -0,0 +1,316 @@
+#include "LibreRTOS.h"
+#include "TheHeader.h"
+#include <boost/test/unit_test.hpp>
+#include <thread>
+#include <vector>
+
+#if (LIBRERTOS_QUEUE_LOCKFREE != 0)
+
+/* Built with the lock-free queue enabled:
+ scripts/run_config_tests.sh "-DLIBRERTOS_QUEUE_LOCKFREE=1 -pthread" */
+
+typedef uint64_t QueType;
+
+struct QueueLockFreeFixture {
+  static const int Len = 4;
+  static const len_t CellSize = QUEUE_LOCKFREE_CELL(sizeof(QueType));
+
+  /* Cells of a sequence number and an item. */
+  uint32_t Cells[QUEUE_LOCKFREE_SIZE(Len, sizeof(QueType)) / sizeof(uint32_t)];
+
+  struct Queue_t Que;
+  struct task_t Task;
+
+  QueueLockFreeFixture() {
+    OS_init();
+    OS_start();
+
+    Queue_initLockFree(&Que, &Cells[0], Len, sizeof(QueType));
+  }
+  ~QueueLockFreeFixture() {
+    BOOST_CHECK_EQUAL(OSstate.SchedulerLock, 0);
+
+    /* These should not change after initialization. */
+    BOOST_CHECK_EQUAL(Queue_length(&Que), Len);
+    BOOST_CHECK_EQUAL(Queue_itemSize(&Que), sizeof(QueType));
+    BOOST_CHECK_EQUAL(Que.LockFree, 1);
+  }
+
+  uint32_t sequence(int cell) {
+    return *(uint32_t *)((uint8_t *)&Cells[0] + cell * CellSize);
+  }
+
+  void fill() {
+    for (QueType x = 0; x < (QueType)Len; ++x)
+      BOOST_REQUIRE_EQUAL(Queue_write(&Que, &x), 1);
+  }
+};
+
+const int QueueLockFreeFixture::Len;
+
+BOOST_FIXTURE_TEST_SUITE(QueueLockFree, QueueLockFreeFixture)
+
+BOOST_AUTO_TEST_CASE(init) {
+  BOOST_CHECK_EQUAL(Que.LockFree, 1);
+  BOOST_CHECK_EQUAL(Que.WritePos, 0);
+  BOOST_CHECK_EQUAL(Que.ReadPos, 0);
+  BOOST_CHECK_EQUAL(Que.Buff, (void *)&Cells[0]);
+
+  /* Each cell is free for the write of its position. */
+  for (int i = 0; i < Len; ++i)
+    BOOST_CHECK_EQUAL(sequence(i), (uint32_t)i);
+
+  BOOST_CHECK_EQUAL(Queue_used(&Que), 0);
+  BOOST_CHECK_EQUAL(Queue_free(&Que), Len);
+
+#if (LIBRERTOS_COMPACT_LISTS == 0)
+  const struct taskListNode_t *nodeHead =
+      (struct taskListNode_t *)&Que.Event.ListRead;
+  BOOST_CHECK_EQUAL(Que.Event.ListRead.Head, nodeHead);
+#endif
+  BOOST_CHECK_EQUAL(Que.Event.ListRead.Length, 0);
+  BOOST_CHECK_EQUAL(Que.Event.ListWrite.Length, 0);
+}
+
+BOOST_AUTO_TEST_CASE(init_not_power_of_2) {
+  struct Queue_t que;
+
+  BOOST_CHECK_THROW(Queue_initLockFree(&que, &Cells[0], 3, sizeof(QueType)),
+                    int);
+  BOOST_CHECK_THROW(Queue_initLockFree(&que, &Cells[0], 0, sizeof(QueType)),
+                    int);
+}
+
+BOOST_AUTO_TEST_CASE(queue_init_not_lock_free) {
+  struct Queue_t que;
+  QueType buff[3];
+
+  Queue_init(&que, &buff[0], 3, sizeof(QueType));
+
+  BOOST_CHECK_EQUAL(que.LockFree, 0);
+}
+
+BOOST_AUTO_TEST_CASE(write_read) {
+  QueType x;
+
+  BOOST_CHECK_EQUAL(Queue_read(&Que, &x), 0);
+
+  fill();
+
+  x = Len;
+  BOOST_CHECK_EQUAL(Queue_write(&Que, &x), 0);
+  BOOST_CHECK_EQUAL(Queue_used(&Que), Len);
+  BOOST_CHECK_EQUAL(Queue_free(&Que), 0);
+
+  for (QueType i = 0; i < (QueType)Len; ++i) {
+    BOOST_CHECK_EQUAL(Queue_read(&Que, &x), 1);
+    BOOST_CHECK_EQUAL(x, i);
+  }
+
+  BOOST_CHECK_EQUAL(Queue_read(&Que, &x), 0);
+  BOOST_CHECK_EQUAL(Queue_used(&Que), 0);
+}
+
+BOOST_AUTO_TEST_CASE(sequence_numbers) {
+  QueType x = 7;
+
+  /* Written cell is ready for the read of its position. */
+  Queue_write(&Que, &x);
+  BOOST_CHECK_EQUAL(sequence(0), 1);
+  BOOST_CHECK_EQUAL(Que.WritePos, 1);
+
+  /* Read cell is free for the write one lap later. */
+  Queue_read(&Que, &x);
+  BOOST_CHECK_EQUAL(sequence(0), (uint32_t)Len);
+  BOOST_CHECK_EQUAL(Que.ReadPos, 1);
+}
+
+BOOST_AUTO_TEST_CASE(wrap) {
+  QueType x;
+
+  for (QueType i = 0; i < 5 * (QueType)Len + 1; ++i) {
+    BOOST_CHECK_EQUAL(Queue_write(&Que, &i), 1);
+    BOOST_CHECK_EQUAL(Queue_read(&Que, &x), 1);
+    BOOST_CHECK_EQUAL(x, i);
+  }
+
+  BOOST_CHECK_EQUAL(Queue_used(&Que), 0);
+}
+
+BOOST_AUTO_TEST_CASE(position_overflow) {
+  QueType x;
+
+  /* Each cell free for the write of the next position that maps to it. */
+  Que.WritePos = Que.ReadPos = (uint32_t)-2;
+  for (int i = 0; i < Len; ++i) {
+    uint32_t pos = (uint32_t)-2 + (uint32_t)i;
+    *(uint32_t *)((uint8_t *)&Cells[0] + (pos & (Len - 1)) * CellSize) = pos;
+  }
+
+  for (QueType i = 0; i < 3 * (QueType)Len; ++i) {
+    BOOST_CHECK_EQUAL(Queue_write(&Que, &i), 1);
+    BOOST_CHECK_EQUAL(Queue_used(&Que), 1);
+    BOOST_CHECK_EQUAL(Queue_read(&Que, &x), 1);
+    BOOST_CHECK_EQUAL(x, i);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(pendread_1_tick) {
+  OS_taskCreate(&Task, 0, NULL, NULL);
+  setCurrentTask(&Task);
+  Queue_pendRead(&Que, 1);
+
+  BOOST_CHECK_EQUAL(Task.NodeEvent.List, &Que.Event.ListRead);
+  BOOST_CHECK_EQUAL(Task.NodeDelay.List, &OSstate.BlockedTaskList1);
+  BOOST_CHECK_EQUAL(Que.Event.ListRead.Length, 1);
+}
+
+BOOST_AUTO_TEST_CASE(pendread_on_not_empty_queue) {
+  QueType x = 1;
+
+  Queue_write(&Que, &x);
+
+  OS_taskCreate(&Task, 0, NULL, NULL);
+  setCurrentTask(&Task);
+  Queue_pendRead(&Que, 1);
+
+  BOOST_CHECK_EQUAL(Task.NodeEvent.List, (void *)0);
+  BOOST_CHECK_EQUAL(Task.NodeDelay.List, (void *)0);
+  BOOST_CHECK_EQUAL(Que.Event.ListRead.Length, 0);
+}
+
+BOOST_AUTO_TEST_CASE(write_unblock_task) {
+  QueType x = 1;
+
+  OS_taskCreate(&Task, 0, NULL, NULL);
+  setCurrentTask(&Task);
+  Queue_pendRead(&Que, MAX_DELAY);
+  setCurrentTask(NULL);
+
+  BOOST_CHECK_EQUAL(Queue_write(&Que, &x), 1);
+
+  BOOST_CHECK_EQUAL(Task.NodeEvent.List, (void *)0);
+  BOOST_CHECK_EQUAL(Task.NodeDelay.List, (void *)0);
+  BOOST_CHECK_EQUAL(Que.Event.ListRead.Length, 0);
+}
+
+BOOST_AUTO_TEST_CASE(pendwrite_on_full_queue) {
+  fill();
+
+  OS_taskCreate(&Task, 0, NULL, NULL);
+  setCurrentTask(&Task);
+  Queue_pendWrite(&Que, 1);
+
+  BOOST_CHECK_EQUAL(Task.NodeEvent.List, &Que.Event.ListWrite);
+  BOOST_CHECK_EQUAL(Task.NodeDelay.List, &OSstate.BlockedTaskList1);
+  BOOST_CHECK_EQUAL(Que.Event.ListWrite.Length, 1);
+}
+
+BOOST_AUTO_TEST_CASE(read_unblock_task) {
+  QueType x;
+
+  fill();
+
+  OS_taskCreate(&Task, 0, NULL, NULL);
+  setCurrentTask(&Task);
+  Queue_pendWrite(&Que, MAX_DELAY);
+  setCurrentTask(NULL);
+
+  BOOST_CHECK_EQUAL(Queue_read(&Que, &x), 1);
+
+  BOOST_CHECK_EQUAL(Task.NodeEvent.List, (void *)0);
+  BOOST_CHECK_EQUAL(Task.NodeDelay.List, (void *)0);
+  BOOST_CHECK_EQUAL(Que.Event.ListWrite.Length, 0);
+}
+
+BOOST_AUTO_TEST_CASE(readpend) {
+  QueType x = 5;
+
+  OS_taskCreate(&Task, 0, NULL, NULL);
+  setCurrentTask(&Task);
+
+  BOOST_CHECK_EQUAL(Queue_readPend(&Que, &x, 1), 0);
+  BOOST_CHECK_EQUAL(Task.NodeEvent.List, &Que.Event.ListRead);
+
+  setCurrentTask(NULL);
+  Queue_write(&Que, &x);
+  x = 0;
+
+  setCurrentTask(&Task);
+  BOOST_CHECK_EQUAL(Queue_readPend(&Que, &x, 1), 1);
+  BOOST_CHECK_EQUAL(x, 5);
+}
+
+BOOST_AUTO_TEST_CASE(threads) {
+  const int numThreads = 4;
+  const uint32_t n = 50000;
+  uint32_t cells[QUEUE_LOCKFREE_SIZE(16, sizeof(uint32_t)) / sizeof(uint32_t)];
+  struct Queue_t que;
+  std::vector<std::thread> threads;
+  std::vector<std::vector<uint32_t> > received(numThreads);
+  bool ordered[numThreads];
+
+  Queue_initLockFree(&que, &cells[0], 16, sizeof(uint32_t));
+
+  /* Items are the producer in the high byte and a count in the others. */
+  for (int t = 0; t < numThreads; ++t) {
+    threads.push_back(std::thread([&que, t]() {
+      for (uint32_t i = 0; i < n;) {
+        uint32_t x = ((uint32_t)t << 24) | i;
+        if (Queue_write(&que, &x))
+          ++i;
+      }
+    }));
+  }
+
+  for (int t = 0; t < numThreads; ++t) {
+    ordered[t] = true;
+    threads.push_back(std::thread([&, t]() {
+      uint32_t last[numThreads];
+      bool first[numThreads];
+
+      for (int p = 0; p < numThreads; ++p)
+        first[p] = true;
+
+      for (uint32_t i = 0; i < n;) {
+        uint32_t x;
+        if (Queue_read(&que, &x)) {
+          uint32_t producer = x >> 24;
+          uint32_t count = x & 0xFFFFFF;
+
+          /* Items of one producer are read in order by each consumer. */
+          if (!first[producer] && count <= last[producer])
+            ordered[t] = false;
+          first[producer] = false;
+          last[producer] = count;
+
+          received[t].push_back(x);
+          ++i;
+        }
+      }
+    }));
+  }
+
+  for (size_t i = 0; i < threads.size(); ++i)
+    threads[i].join();
+
+  /* Every item read exactly once. */
+  std::vector<uint8_t> seen(numThreads * n, 0);
+  bool once = true;
+  for (int t = 0; t < numThreads; ++t) {
+    BOOST_CHECK(ordered[t]);
+    for (size_t i = 0; i < received[t].size(); ++i) {
+      uint32_t x = received[t][i];
+      size_t index = (x >> 24) * n + (x & 0xFFFFFF);
+      if (seen[index]++ != 0)
+        once = false;
+    }
+  }
+
+  BOOST_CHECK(once);
+  BOOST_CHECK_EQUAL(Queue_used(&que), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif /* LIBRERTOS_QUEUE_LOCKFREE */
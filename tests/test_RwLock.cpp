@@ -0,0 +1,367 @@
+#include "LibreRTOS.h"
+#include "TheHeader.h"
+#include <boost/test/unit_test.hpp>
+
+struct RwLockFixture {
+  static const int NumTasks = 4;
+
+  struct RwLock_t Rw;
+  struct task_t Task[NumTasks];
+
+  RwLockFixture() {
+    OS_init();
+    OS_start();
+
+    RwLock_init(&Rw, 0);
+
+    for (int i = 0; i < NumTasks; ++i)
+      OS_taskCreate(&Task[i], (priority_t)i, NULL, NULL);
+  }
+  ~RwLockFixture() { BOOST_CHECK_EQUAL(OSstate.SchedulerLock, 0); }
+
+  void checkUnblocked(struct task_t *task) {
+    BOOST_CHECK_EQUAL(task->NodeEvent.List, (void *)0);
+    BOOST_CHECK_EQUAL(task->NodeDelay.List, (void *)0);
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(RwLock, RwLockFixture)
+
+BOOST_AUTO_TEST_CASE(init) {
+  BOOST_CHECK_EQUAL(Rw.Readers, 0);
+  BOOST_CHECK_EQUAL(Rw.Writer, (void *)0);
+  BOOST_CHECK_EQUAL(Rw.WriterPreference, 0);
+
+  BOOST_CHECK_EQUAL(RwLock_getReaders(&Rw), 0);
+  BOOST_CHECK_EQUAL(RwLock_getWriter(&Rw), (void *)0);
+
+#if (LIBRERTOS_COMPACT_LISTS == 0)
+  const struct taskListNode_t *nodeHeadRead =
+      (struct taskListNode_t *)&Rw.Event.ListRead;
+  BOOST_CHECK_EQUAL(Rw.Event.ListRead.Head, nodeHeadRead);
+  BOOST_CHECK_EQUAL(Rw.Event.ListRead.Tail, nodeHeadRead);
+#endif
+  BOOST_CHECK_EQUAL(Rw.Event.ListRead.Length, 0);
+
+#if (LIBRERTOS_COMPACT_LISTS == 0)
+  const struct taskListNode_t *nodeHeadWrite =
+      (struct taskListNode_t *)&Rw.Event.ListWrite;
+  BOOST_CHECK_EQUAL(Rw.Event.ListWrite.Head, nodeHeadWrite);
+  BOOST_CHECK_EQUAL(Rw.Event.ListWrite.Tail, nodeHeadWrite);
+#endif
+  BOOST_CHECK_EQUAL(Rw.Event.ListWrite.Length, 0);
+}
+
+BOOST_AUTO_TEST_CASE(init_writer_preference) {
+  RwLock_init(&Rw, 1);
+
+  BOOST_CHECK_EQUAL(Rw.WriterPreference, 1);
+}
+
+BOOST_AUTO_TEST_CASE(read_lock_shared) {
+  setCurrentTask(&Task[0]);
+  BOOST_CHECK_EQUAL(RwLock_readLock(&Rw), 1);
+  setCurrentTask(&Task[1]);
+  BOOST_CHECK_EQUAL(RwLock_readLock(&Rw), 1);
+
+  BOOST_CHECK_EQUAL(RwLock_getReaders(&Rw), 2);
+  BOOST_CHECK_EQUAL(RwLock_getWriter(&Rw), (void *)0);
+}
+
+BOOST_AUTO_TEST_CASE(read_unlock) {
+  setCurrentTask(&Task[0]);
+  RwLock_readLock(&Rw);
+  RwLock_readLock(&Rw);
+
+  BOOST_CHECK_EQUAL(RwLock_readUnlock(&Rw), 1);
+  BOOST_CHECK_EQUAL(RwLock_getReaders(&Rw), 1);
+  BOOST_CHECK_EQUAL(RwLock_readUnlock(&Rw), 1);
+  BOOST_CHECK_EQUAL(RwLock_getReaders(&Rw), 0);
+}
+
+BOOST_AUTO_TEST_CASE(read_unlock_unlocked) {
+  setCurrentTask(&Task[0]);
+  BOOST_CHECK_EQUAL(RwLock_readUnlock(&Rw), 0);
+
+  BOOST_CHECK_EQUAL(RwLock_getReaders(&Rw), 0);
+}
+
+BOOST_AUTO_TEST_CASE(write_lock) {
+  setCurrentTask(&Task[0]);
+  BOOST_CHECK_EQUAL(RwLock_writeLock(&Rw), 1);
+
+  BOOST_CHECK_EQUAL(RwLock_getReaders(&Rw), 0);
+  BOOST_CHECK_EQUAL(RwLock_getWriter(&Rw), &Task[0]);
+}
+
+BOOST_AUTO_TEST_CASE(write_lock_exclusive) {
+  setCurrentTask(&Task[0]);
+  RwLock_writeLock(&Rw);
+
+  setCurrentTask(&Task[1]);
+  BOOST_CHECK_EQUAL(RwLock_writeLock(&Rw), 0);
+  BOOST_CHECK_EQUAL(RwLock_readLock(&Rw), 0);
+
+  /* Not recursive. */
+  setCurrentTask(&Task[0]);
+  BOOST_CHECK_EQUAL(RwLock_writeLock(&Rw), 0);
+  BOOST_CHECK_EQUAL(RwLock_readLock(&Rw), 0);
+
+  BOOST_CHECK_EQUAL(RwLock_getReaders(&Rw), 0);
+  BOOST_CHECK_EQUAL(RwLock_getWriter(&Rw), &Task[0]);
+}
+
+BOOST_AUTO_TEST_CASE(write_lock_read_locked) {
+  setCurrentTask(&Task[0]);
+  RwLock_readLock(&Rw);
+
+  BOOST_CHECK_EQUAL(RwLock_writeLock(&Rw), 0);
+  setCurrentTask(&Task[1]);
+  BOOST_CHECK_EQUAL(RwLock_writeLock(&Rw), 0);
+
+  BOOST_CHECK_EQUAL(RwLock_getReaders(&Rw), 1);
+  BOOST_CHECK_EQUAL(RwLock_getWriter(&Rw), (void *)0);
+}
+
+BOOST_AUTO_TEST_CASE(write_unlock) {
+  setCurrentTask(&Task[0]);
+  RwLock_writeLock(&Rw);
+
+  BOOST_CHECK_EQUAL(RwLock_writeUnlock(&Rw), 1);
+  BOOST_CHECK_EQUAL(RwLock_getWriter(&Rw), (void *)0);
+
+  setCurrentTask(&Task[1]);
+  BOOST_CHECK_EQUAL(RwLock_readLock(&Rw), 1);
+}
+
+BOOST_AUTO_TEST_CASE(write_unlock_unlocked) {
+  setCurrentTask(&Task[0]);
+  BOOST_CHECK_EQUAL(RwLock_writeUnlock(&Rw), 0);
+}
+
+BOOST_AUTO_TEST_CASE(write_unlock_not_owner) {
+  setCurrentTask(&Task[0]);
+  RwLock_writeLock(&Rw);
+
+  setCurrentTask(&Task[1]);
+  BOOST_CHECK_EQUAL(RwLock_writeUnlock(&Rw), 0);
+  BOOST_CHECK_EQUAL(RwLock_getWriter(&Rw), &Task[0]);
+}
+
+BOOST_AUTO_TEST_CASE(pend_read_0_tick) {
+  setCurrentTask(&Task[0]);
+  RwLock_writeLock(&Rw);
+
+  setCurrentTask(&Task[1]);
+  RwLock_pendRead(&Rw, 0);
+
+  checkUnblocked(&Task[1]);
+  BOOST_CHECK_EQUAL(Rw.Event.ListRead.Length, 0);
+}
+
+BOOST_AUTO_TEST_CASE(pend_read_1_tick) {
+  setCurrentTask(&Task[0]);
+  RwLock_writeLock(&Rw);
+
+  setCurrentTask(&Task[1]);
+  RwLock_pendRead(&Rw, 1);
+
+  BOOST_CHECK_EQUAL(Task[1].NodeEvent.List, &Rw.Event.ListRead);
+  BOOST_CHECK_EQUAL(Task[1].NodeDelay.List, &OSstate.BlockedTaskList1);
+  BOOST_CHECK_EQUAL(Rw.Event.ListRead.Length, 1);
+}
+
+BOOST_AUTO_TEST_CASE(pend_read_read_locked) {
+  setCurrentTask(&Task[0]);
+  RwLock_readLock(&Rw);
+
+  setCurrentTask(&Task[1]);
+  RwLock_pendRead(&Rw, 1);
+
+  checkUnblocked(&Task[1]);
+  BOOST_CHECK_EQUAL(Rw.Event.ListRead.Length, 0);
+}
+
+BOOST_AUTO_TEST_CASE(pend_write_1_tick) {
+  setCurrentTask(&Task[0]);
+  RwLock_readLock(&Rw);
+
+  setCurrentTask(&Task[1]);
+  RwLock_pendWrite(&Rw, 1);
+
+  BOOST_CHECK_EQUAL(Task[1].NodeEvent.List, &Rw.Event.ListWrite);
+  BOOST_CHECK_EQUAL(Task[1].NodeDelay.List, &OSstate.BlockedTaskList1);
+  BOOST_CHECK_EQUAL(Rw.Event.ListWrite.Length, 1);
+}
+
+BOOST_AUTO_TEST_CASE(pend_write_unlocked) {
+  setCurrentTask(&Task[1]);
+  RwLock_pendWrite(&Rw, 1);
+
+  checkUnblocked(&Task[1]);
+  BOOST_CHECK_EQUAL(Rw.Event.ListWrite.Length, 0);
+}
+
+BOOST_AUTO_TEST_CASE(read_lock_writer_waiting) {
+  setCurrentTask(&Task[0]);
+  RwLock_readLock(&Rw);
+
+  setCurrentTask(&Task[1]);
+  RwLock_pendWrite(&Rw, MAX_DELAY);
+
+  /* Without writer preference new readers share the lock. */
+  setCurrentTask(&Task[2]);
+  BOOST_CHECK_EQUAL(RwLock_readLock(&Rw), 1);
+  BOOST_CHECK_EQUAL(RwLock_getReaders(&Rw), 2);
+}
+
+BOOST_AUTO_TEST_CASE(read_lock_writer_waiting_writer_preference) {
+  RwLock_init(&Rw, 1);
+
+  setCurrentTask(&Task[0]);
+  RwLock_readLock(&Rw);
+
+  setCurrentTask(&Task[1]);
+  RwLock_pendWrite(&Rw, MAX_DELAY);
+
+  /* A waiting writer keeps new readers out, so it does not starve. */
+  setCurrentTask(&Task[2]);
+  BOOST_CHECK_EQUAL(RwLock_readLock(&Rw), 0);
+  BOOST_CHECK_EQUAL(RwLock_getReaders(&Rw), 1);
+
+  RwLock_pendRead(&Rw, MAX_DELAY);
+  BOOST_CHECK_EQUAL(Task[2].NodeEvent.List, &Rw.Event.ListRead);
+}
+
+BOOST_AUTO_TEST_CASE(read_unlock_last_reader_unblocks_writer) {
+  setCurrentTask(&Task[0]);
+  RwLock_readLock(&Rw);
+  setCurrentTask(&Task[1]);
+  RwLock_readLock(&Rw);
+
+  setCurrentTask(&Task[2]);
+  RwLock_pendWrite(&Rw, MAX_DELAY);
+
+  setCurrentTask(&Task[0]);
+  RwLock_readUnlock(&Rw);
+
+  BOOST_CHECK_EQUAL(Task[2].NodeEvent.List, &Rw.Event.ListWrite);
+
+  setCurrentTask(&Task[1]);
+  RwLock_readUnlock(&Rw);
+
+  checkUnblocked(&Task[2]);
+  BOOST_CHECK_EQUAL(Rw.Event.ListWrite.Length, 0);
+}
+
+BOOST_AUTO_TEST_CASE(write_unlock_unblocks_all_readers) {
+  setCurrentTask(&Task[0]);
+  RwLock_writeLock(&Rw);
+
+  setCurrentTask(&Task[1]);
+  RwLock_pendWrite(&Rw, MAX_DELAY);
+  setCurrentTask(&Task[2]);
+  RwLock_pendRead(&Rw, MAX_DELAY);
+  setCurrentTask(&Task[3]);
+  RwLock_pendRead(&Rw, MAX_DELAY);
+
+  setCurrentTask(&Task[0]);
+  RwLock_writeUnlock(&Rw);
+
+  /* All queued readers at once, the writer keeps waiting. */
+  checkUnblocked(&Task[2]);
+  checkUnblocked(&Task[3]);
+  BOOST_CHECK_EQUAL(Rw.Event.ListRead.Length, 0);
+
+  BOOST_CHECK_EQUAL(Task[1].NodeEvent.List, &Rw.Event.ListWrite);
+  BOOST_CHECK_EQUAL(Rw.Event.ListWrite.Length, 1);
+}
+
+BOOST_AUTO_TEST_CASE(write_unlock_unblocks_writer) {
+  setCurrentTask(&Task[0]);
+  RwLock_writeLock(&Rw);
+
+  setCurrentTask(&Task[1]);
+  RwLock_pendWrite(&Rw, MAX_DELAY);
+  setCurrentTask(&Task[2]);
+  RwLock_pendWrite(&Rw, MAX_DELAY);
+
+  setCurrentTask(&Task[0]);
+  RwLock_writeUnlock(&Rw);
+
+  /* Without readers waiting, only the highest priority writer. */
+  checkUnblocked(&Task[2]);
+  BOOST_CHECK_EQUAL(Task[1].NodeEvent.List, &Rw.Event.ListWrite);
+  BOOST_CHECK_EQUAL(Rw.Event.ListWrite.Length, 1);
+}
+
+BOOST_AUTO_TEST_CASE(write_unlock_writer_preference) {
+  RwLock_init(&Rw, 1);
+
+  setCurrentTask(&Task[0]);
+  RwLock_writeLock(&Rw);
+
+  setCurrentTask(&Task[1]);
+  RwLock_pendWrite(&Rw, MAX_DELAY);
+  setCurrentTask(&Task[2]);
+  RwLock_pendRead(&Rw, MAX_DELAY);
+  setCurrentTask(&Task[3]);
+  RwLock_pendRead(&Rw, MAX_DELAY);
+
+  setCurrentTask(&Task[0]);
+  RwLock_writeUnlock(&Rw);
+
+  /* Waiting writer goes first, readers are unblocked after it unlocks. */
+  checkUnblocked(&Task[1]);
+  BOOST_CHECK_EQUAL(Rw.Event.ListRead.Length, 2);
+
+  setCurrentTask(&Task[1]);
+  BOOST_CHECK_EQUAL(RwLock_writeLock(&Rw), 1);
+  BOOST_CHECK_EQUAL(RwLock_writeUnlock(&Rw), 1);
+
+  checkUnblocked(&Task[2]);
+  checkUnblocked(&Task[3]);
+  BOOST_CHECK_EQUAL(Rw.Event.ListRead.Length, 0);
+}
+
+BOOST_AUTO_TEST_CASE(read_lock_pend) {
+  setCurrentTask(&Task[0]);
+  BOOST_CHECK_EQUAL(RwLock_readLockPend(&Rw, 1), 1);
+  checkUnblocked(&Task[0]);
+
+  setCurrentTask(&Task[1]);
+  BOOST_CHECK_EQUAL(RwLock_writeLockPend(&Rw, 1), 0);
+
+  BOOST_CHECK_EQUAL(Task[1].NodeEvent.List, &Rw.Event.ListWrite);
+  BOOST_CHECK_EQUAL(Task[1].NodeDelay.List, &OSstate.BlockedTaskList1);
+}
+
+BOOST_AUTO_TEST_CASE(write_lock_pend) {
+  setCurrentTask(&Task[0]);
+  BOOST_CHECK_EQUAL(RwLock_writeLockPend(&Rw, 1), 1);
+  checkUnblocked(&Task[0]);
+
+  setCurrentTask(&Task[1]);
+  BOOST_CHECK_EQUAL(RwLock_readLockPend(&Rw, 1), 0);
+
+  BOOST_CHECK_EQUAL(Task[1].NodeEvent.List, &Rw.Event.ListRead);
+  BOOST_CHECK_EQUAL(Task[1].NodeDelay.List, &OSstate.BlockedTaskList1);
+}
+
+BOOST_AUTO_TEST_CASE(pend_timeout) {
+  setCurrentTask(&Task[0]);
+  RwLock_readLock(&Rw);
+
+  setCurrentTask(&Task[1]);
+  RwLock_pendWrite(&Rw, 1);
+  setCurrentTask(NULL);
+
+  OS_tick();
+  OS_schedulerLock();
+  OS_schedulerUnlock();
+
+  checkUnblocked(&Task[1]);
+  BOOST_CHECK_EQUAL(Rw.Event.ListWrite.Length, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
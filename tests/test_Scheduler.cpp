@@ -59,6 +59,7 @@ BOOST_AUTO_TEST_CASE(increment_ticks) {
   BOOST_CHECK_EQUAL(OSstate.Tick, n);
 }
 
+#if (LIBRERTOS_TICK_BITS != 64)
 BOOST_AUTO_TEST_CASE(swap_delayed_task_list) {
   OSstate.Tick = MAX_DELAY;
   BOOST_CHECK_EQUAL((tick_t)(OSstate.Tick + 1), 0);
@@ -73,6 +74,7 @@ BOOST_AUTO_TEST_CASE(swap_delayed_task_list) {
 
   BOOST_CHECK_EQUAL(OSstate.Tick, 0);
 }
+#endif
 
 BOOST_AUTO_TEST_CASE(create_task) {
   struct task_t theTask;
@@ -120,8 +122,7 @@ BOOST_AUTO_TEST_CASE(delay_task_not_overflowed) {
   OS_scheduler();
   BOOST_CHECK_EQUAL(taskClosure.NumCalls, 1);
   BOOST_CHECK_EQUAL(task->State, TASKSTATE_BLOCKED);
-  BOOST_CHECK_EQUAL(task->NodeDelay.List,
-                    OSstate.BlockedTaskList_NotOverflowed);
+  BOOST_CHECK_EQUAL(task->NodeDelay.List, blockedTaskList());
   BOOST_CHECK_EQUAL(task->NodeEvent.List, (struct taskHeadList_t *)NULL);
 
   OS_scheduler();
@@ -131,6 +132,7 @@ BOOST_AUTO_TEST_CASE(delay_task_not_overflowed) {
   BOOST_CHECK_EQUAL(taskClosure.NumCalls, 2);
 }
 
+#if (LIBRERTOS_TICK_BITS != 64)
 void taskDelayMaxDelay(taskParameter_t param) {
   (void)param;
   OS_taskDelay(MAX_DELAY);
@@ -167,6 +169,7 @@ BOOST_AUTO_TEST_CASE(delay_task_overflowed) {
   OS_scheduler();
   BOOST_CHECK_EQUAL(taskClosure.NumCalls, 2);
 }
+#endif
 
 BOOST_AUTO_TEST_CASE(delay_task_insertion_order) {
   struct task_t theTask1;
@@ -194,18 +197,21 @@ BOOST_AUTO_TEST_CASE(delay_task_insertion_order) {
   setCurrentTask(task3);
   OS_taskDelay(ticksToWait3);
 
-  BOOST_CHECK_EQUAL(task1->NodeDelay.List,
-                    OSstate.BlockedTaskList_NotOverflowed);
-  BOOST_CHECK_EQUAL(task2->NodeDelay.List,
-                    OSstate.BlockedTaskList_NotOverflowed);
-  BOOST_CHECK_EQUAL(task3->NodeDelay.List,
-                    OSstate.BlockedTaskList_NotOverflowed);
-
-  BOOST_CHECK_EQUAL(OSstate.BlockedTaskList_NotOverflowed->Head->Owner, task1);
-  BOOST_CHECK_EQUAL(OSstate.BlockedTaskList_NotOverflowed->Head->Next->Owner,
-                    task3);
-  BOOST_CHECK_EQUAL(OSstate.BlockedTaskList_NotOverflowed->Tail->Owner, task2);
-  BOOST_CHECK_EQUAL(OSstate.BlockedTaskList_NotOverflowed->Length, 3);
+  BOOST_CHECK_EQUAL(task1->NodeDelay.List, blockedTaskList());
+  BOOST_CHECK_EQUAL(task2->NodeDelay.List, blockedTaskList());
+  BOOST_CHECK_EQUAL(task3->NodeDelay.List, blockedTaskList());
+
+#if (LIBRERTOS_COMPACT_LISTS == 0)
+  BOOST_CHECK_EQUAL(blockedTaskList()->Head->Owner, task1);
+  BOOST_CHECK_EQUAL(blockedTaskList()->Head->Next->Owner, task3);
+  BOOST_CHECK_EQUAL(blockedTaskList()->Tail->Owner, task2);
+#else
+  const struct taskHeadList_t *list = blockedTaskList();
+  BOOST_CHECK_EQUAL(OS_listOwner(list->Head), task1);
+  BOOST_CHECK_EQUAL(OS_listOwner(OS_listNode(list->Head)->Next), task3);
+  BOOST_CHECK_EQUAL(OS_listOwner(list->Tail), task2);
+#endif
+  BOOST_CHECK_EQUAL(blockedTaskList()->Length, 3);
 }
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,156 @@
+#include "LibreRTOS.h"
+#include "Simulator.h"
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+
+struct SimulatorFixture {
+  ~SimulatorFixture() { BOOST_CHECK_EQUAL(OSstate.SchedulerLock, 0); }
+};
+
+BOOST_FIXTURE_TEST_SUITE(Simulation, SimulatorFixture)
+
+BOOST_AUTO_TEST_CASE(periodic_isr_event_task) {
+  Simulator sim;
+  int rx = sim.addFifo("rx", 16, 4);
+  sim.addPeriodicIsr(rx, 10);
+  sim.addTask(rx, 0, 1);
+
+  sim.run(1000);
+
+  BOOST_CHECK_EQUAL(sim.ticks(), 1000);
+  BOOST_CHECK_EQUAL(sim.report(rx).Written, 100);
+  BOOST_CHECK_EQUAL(sim.report(rx).Dropped, 0);
+  BOOST_CHECK_EQUAL(sim.report(rx).Read, 100);
+
+  /* Task pends on the fifo, reads in the same tick as the interrupt. */
+  BOOST_CHECK_EQUAL(sim.report(rx).Latency.Count, 100);
+  BOOST_CHECK_EQUAL(sim.report(rx).Latency.Max, 0);
+  BOOST_CHECK_EQUAL(sim.report(rx).Depth.Max, 0);
+}
+
+BOOST_AUTO_TEST_CASE(periodic_task_lags) {
+  Simulator sim;
+  int que = sim.addQueue("que", 4, 4);
+  sim.addPeriodicIsr(que, 10);
+  sim.addTask(que, 0, 1, 1, 20);
+
+  sim.run(1000);
+
+  /* Consumer reads half of the messages, the queue is always full. */
+  BOOST_CHECK_GT(sim.report(que).Dropped, 0);
+  BOOST_CHECK_EQUAL(sim.report(que).Depth.Max, 4);
+  BOOST_CHECK_EQUAL(sim.report(que).Written + sim.report(que).Dropped, 100);
+  BOOST_CHECK_LE(sim.report(que).Read, 50);
+  BOOST_CHECK_GE(sim.report(que).Latency.Max, 40);
+}
+
+BOOST_AUTO_TEST_CASE(cpu_budget_by_priority) {
+  Simulator sim;
+  int high = sim.addQueue("high", 4, 4);
+  int low = sim.addQueue("low", 4, 4);
+  sim.addPeriodicIsr(high, 1);
+  sim.addPeriodicIsr(low, 1);
+  sim.addTask(high, 2, 1);
+  sim.addTask(low, 1, 1);
+  sim.setCpuBudget(1);
+
+  sim.run(100);
+
+  /* Higher priority task uses the whole CPU. */
+  BOOST_CHECK_EQUAL(sim.report(high).Read, 100);
+  BOOST_CHECK_EQUAL(sim.report(high).Dropped, 0);
+  BOOST_CHECK_EQUAL(sim.report(low).Read, 0);
+  BOOST_CHECK_EQUAL(sim.report(low).Dropped, 96);
+}
+
+BOOST_AUTO_TEST_CASE(poisson_isr_repeatable) {
+  const double rate = 0.25;
+  const unsigned long long ticks = 10000;
+  SimObjectReport reports[3];
+  unsigned long seeds[3] = {7, 7, 8};
+
+  for (int i = 0; i < 3; ++i) {
+    Simulator sim(seeds[i]);
+    int rx = sim.addFifo("rx", 32, 4);
+    sim.addPoissonIsr(rx, rate);
+    sim.addTask(rx, 0, 2);
+
+    sim.run(ticks);
+    reports[i] = sim.report(rx);
+  }
+
+  /* Mean arrival rate, within about 5 standard deviations. Long runs are
+   done by run_sim.sh with sim/gateway.sim. */
+  BOOST_CHECK_CLOSE((double)reports[0].Written, rate * ticks, 10.0);
+
+  /* Same seed, same results. */
+  BOOST_CHECK_EQUAL(reports[0].Written, reports[1].Written);
+  BOOST_CHECK_EQUAL(reports[0].Read, reports[1].Read);
+  BOOST_CHECK_EQUAL(reports[0].Latency.Sum, reports[1].Latency.Sum);
+  BOOST_CHECK_EQUAL(reports[0].Depth.Sum, reports[1].Depth.Sum);
+
+  /* Another seed, another arrival sequence. */
+  BOOST_CHECK_NE(reports[0].Written, reports[2].Written);
+}
+
+BOOST_AUTO_TEST_CASE(load_script) {
+  std::istringstream script("# comment\n"
+                            "seed 3\n"
+                            "tickrate 1000\n"
+                            "cpu 4\n"
+                            "fifo rx 16 4 # inline comment\n"
+                            "queue cmd 4 8\n"
+                            "periodic rx 10 5\n"
+                            "poisson cmd 0.1\n"
+                            "task rx 2 1\n"
+                            "task cmd 1 1 2 5\n"
+                            "run 500\n");
+  Simulator sim;
+  std::string error;
+
+  BOOST_CHECK(sim.load(script, error));
+  BOOST_CHECK_EQUAL(error, "");
+  BOOST_CHECK_EQUAL(sim.numObjects(), 2);
+  BOOST_CHECK_EQUAL(sim.report(0).Name, "rx");
+  BOOST_CHECK_EQUAL(sim.report(1).Name, "cmd");
+  BOOST_CHECK_EQUAL(sim.scriptedTicks(), 500);
+
+  sim.run(sim.scriptedTicks());
+  BOOST_CHECK_EQUAL(sim.report(0).Written, 50);
+}
+
+BOOST_AUTO_TEST_CASE(load_script_errors) {
+  const char *scripts[] = {
+      "unknown 1\n",           /* Unknown command */
+      "task rx 1 1\n",         /* Unknown object */
+      "fifo rx 16\n",          /* Missing argument */
+      "fifo rx 16 2\n",        /* Message smaller than the timestamp */
+      "fifo rx 65540 4\n",     /* Length out of len_t range */
+      "fifo rx 16 4\n"
+      "task rx 256 1\n",       /* Priority out of priority_t range */
+      "fifo rx 16 4\n"
+      "task rx -1 1\n",        /* Negative priority */
+#if (LIBRERTOS_TICK_BITS == 16)
+      "fifo rx 16 4\n"
+      "periodic rx 65536\n",   /* Period out of tick_t range */
+      "fifo rx 16 4\n"
+      "periodic rx 1 65536\n", /* Phase out of tick_t range */
+      "fifo rx 16 4\n"
+      "task rx 1 1 1 65536\n", /* Task period out of tick_t range */
+#endif
+      "fifo rx 16 4\n"
+      "task rx 1 1\n"
+      "task rx 1 1\n",         /* Priority already used */
+  };
+
+  for (unsigned i = 0; i < sizeof(scripts) / sizeof(scripts[0]); ++i) {
+    std::istringstream script(scripts[i]);
+    Simulator sim;
+    std::string error;
+
+    BOOST_CHECK(!sim.load(script, error));
+    BOOST_CHECK_NE(error, "");
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,168 @@
+#include "LibreRTOS.h"
+#include "TheHeader.h"
+#include <boost/test/unit_test.hpp>
+
+#if (LIBRERTOS_STATISTICS != 0)
+
+/* Built with run time statistics enabled, without the other options that
+ read US_systemRunTime():
+ scripts/run_config_tests.sh "-DLIBRERTOS_STATISTICS=1" \
+     tests/test_Statistics.cpp */
+
+struct StatisticsFixture {
+  struct task_t Task1;
+  struct task_t Task2;
+
+  StatisticsFixture() {
+    OS_init();
+    OS_start();
+  }
+  ~StatisticsFixture() { BOOST_CHECK_EQUAL(OSstate.SchedulerLock, 0); }
+};
+
+static void taskRun100(void *) {
+  librertos_test_add_run_time(100);
+
+  /* Delay so scheduler does not reschedule task to run again. */
+  OS_taskDelay(MAX_DELAY);
+}
+
+static void taskRun300(void *) {
+  librertos_test_add_run_time(300);
+
+  /* Delay so scheduler does not reschedule task to run again. */
+  OS_taskDelay(MAX_DELAY);
+}
+
+static void taskRunNTimes(void *param) {
+  int *n = (int *)param;
+
+  if (--*n == 0) {
+    /* Delay so scheduler does not reschedule task to run again. */
+    OS_taskDelay(MAX_DELAY);
+  }
+}
+
+BOOST_FIXTURE_TEST_SUITE(Statistics, StatisticsFixture)
+
+BOOST_AUTO_TEST_CASE(init_task) {
+  OS_taskCreate(&Task1, 0, &taskRun100, NULL);
+
+  BOOST_CHECK_EQUAL(OS_getTaskRunTime(&Task1), 0);
+  BOOST_CHECK_EQUAL(OS_getTaskActivations(&Task1), 0);
+}
+
+BOOST_AUTO_TEST_CASE(count_activations) {
+  int n = 3;
+
+  OS_taskCreate(&Task1, 0, &taskRunNTimes, &n);
+
+  OS_scheduler();
+  BOOST_CHECK_EQUAL(n, 0);
+  BOOST_CHECK_EQUAL(OS_getTaskActivations(&Task1), 3);
+
+  OS_scheduler();
+  BOOST_CHECK_EQUAL(OS_getTaskActivations(&Task1), 3);
+}
+
+BOOST_AUTO_TEST_CASE(accumulate_run_time) {
+  OS_taskCreate(&Task1, 0, &taskRun100, NULL);
+  OS_taskCreate(&Task2, 1, &taskRun300, NULL);
+
+  OS_scheduler();
+
+  /* Run time measured around the task function. */
+  BOOST_CHECK_GE(OS_getTaskRunTime(&Task1), 100);
+  BOOST_CHECK_LT(OS_getTaskRunTime(&Task1), 200);
+  BOOST_CHECK_GE(OS_getTaskRunTime(&Task2), 300);
+  BOOST_CHECK_LT(OS_getTaskRunTime(&Task2), 400);
+
+  BOOST_CHECK_EQUAL(OS_getTaskActivations(&Task1), 1);
+  BOOST_CHECK_EQUAL(OS_getTaskActivations(&Task2), 1);
+
+  /* Tasks and no-task time are part of the total run time. */
+  BOOST_CHECK_LE(OS_getTaskRunTime(&Task1) + OS_getTaskRunTime(&Task2) +
+                     OS_getNoTaskRunTime(),
+                 OS_getTotalRunTime());
+}
+
+BOOST_AUTO_TEST_CASE(no_task_run_time) {
+  stattime_t noTask = OS_getNoTaskRunTime();
+
+  OS_scheduler();
+  librertos_test_add_run_time(100);
+  OS_scheduler();
+
+  BOOST_CHECK_GE(OS_getNoTaskRunTime() - noTask, 100);
+  BOOST_CHECK_LE(OS_getNoTaskRunTime(), OS_getTotalRunTime());
+}
+
+BOOST_AUTO_TEST_CASE(snapshot) {
+  struct OSstatistics_t stats;
+
+  OS_taskCreate(&Task1, 0, &taskRun100, NULL);
+  OS_scheduler();
+
+  OS_getStatistics(&stats);
+
+  BOOST_CHECK_EQUAL(stats.TotalRunTime, OS_getTotalRunTime());
+  BOOST_CHECK_EQUAL(stats.NoTaskRunTime, OS_getNoTaskRunTime());
+  BOOST_CHECK_EQUAL(stats.TaskRunTime[0], OS_getTaskRunTime(&Task1));
+  BOOST_CHECK_EQUAL(stats.TaskActivations[0], OS_getTaskActivations(&Task1));
+
+  /* No task with this priority. */
+  BOOST_CHECK_EQUAL(stats.TaskRunTime[1], 0);
+  BOOST_CHECK_EQUAL(stats.TaskActivations[1], 0);
+}
+
+BOOST_AUTO_TEST_CASE(load_over_window) {
+  struct OSstatistics_t start;
+  struct OSstatistics_t end;
+
+  OS_taskCreate(&Task1, 0, &taskRun100, NULL);
+  OS_taskCreate(&Task2, 1, &taskRun300, NULL);
+
+  OS_getStatistics(&start);
+  OS_scheduler();
+  OS_getStatistics(&end);
+
+  /* Load in parts per thousand, kernel overhead counts as no-task time. */
+  stattime_t load1 = OS_statisticsTaskLoad(&start, &end, 0);
+  stattime_t load2 = OS_statisticsTaskLoad(&start, &end, 1);
+  stattime_t loadNoTask = OS_statisticsNoTaskLoad(&start, &end);
+
+  BOOST_CHECK_GT(load1, 200);
+  BOOST_CHECK_LE(load1, 250);
+  BOOST_CHECK_GT(load2, 700);
+  BOOST_CHECK_LE(load2, 750);
+  BOOST_CHECK_LE(load1 + load2 + loadNoTask, 1000);
+}
+
+BOOST_AUTO_TEST_CASE(load_of_task_not_run_in_window) {
+  struct OSstatistics_t start;
+  struct OSstatistics_t end;
+
+  OS_taskCreate(&Task1, 0, &taskRun100, NULL);
+  OS_scheduler();
+
+  OS_getStatistics(&start);
+  librertos_test_add_run_time(100);
+  OS_scheduler();
+  OS_getStatistics(&end);
+
+  BOOST_CHECK_EQUAL(OS_statisticsTaskLoad(&start, &end, 0), 0);
+  BOOST_CHECK_GT(OS_statisticsNoTaskLoad(&start, &end), 900);
+}
+
+BOOST_AUTO_TEST_CASE(load_of_empty_window) {
+  struct OSstatistics_t stats;
+
+  OS_getStatistics(&stats);
+
+  BOOST_CHECK_EQUAL(OS_statisticsTaskLoad(&stats, &stats, 0), 0);
+  BOOST_CHECK_EQUAL(OS_statisticsNoTaskLoad(&stats, &stats), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif /* LIBRERTOS_STATISTICS */
@@ -63,11 +63,21 @@ BOOST_AUTO_TEST_CASE(init) {
   BOOST_CHECK_EQUAL(Timer1.Function, &timerFunction);
   BOOST_CHECK_EQUAL(Timer1.Parameter, (void *)1);
 
-  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, (void *)NULL);
-  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Previous, (void *)NULL);
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.Value, 0);
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.List, (void *)NULL);
+#if (LIBRERTOS_COMPACT_LISTS == 0)
+#if (LIBRERTOS_COMPACT_LISTS == 0)
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, (void *)NULL);
+#else
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, LIST_END);
+#endif
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Previous, (void *)NULL);
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.Owner, &Timer1);
+#else
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, LIST_END);
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Previous, LIST_END);
+  BOOST_CHECK_EQUAL(OS_listOwner(timerNode(&Timer1)), &Timer1);
+#endif
 }
 
 BOOST_AUTO_TEST_CASE(start_stopped_timer) {
@@ -79,19 +89,24 @@ BOOST_AUTO_TEST_CASE(start_stopped_timer) {
   BOOST_CHECK_EQUAL(Timer1.Function, &timerFunction);
   BOOST_CHECK_EQUAL(Timer1.Parameter, (void *)1);
 
-  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, (void *)&OSstate.TimerUnorderedList);
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next,
+                    listEnd(&OSstate.TimerUnorderedList));
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.Previous,
-                    (void *)&OSstate.TimerUnorderedList);
+                    listEnd(&OSstate.TimerUnorderedList));
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.Value, 0);
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.List, &OSstate.TimerUnorderedList);
+#if (LIBRERTOS_COMPACT_LISTS == 0)
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.Owner, &Timer1);
+#else
+  BOOST_CHECK_EQUAL(OS_listOwner(timerNode(&Timer1)), &Timer1);
+#endif
 }
 
 BOOST_AUTO_TEST_CASE(start_running_timer) {
   // Manually insert timer on ordered timers list
   Timer1.NodeTimer.Value = (tick_t)(OSstate.Tick + Timer1.Period);
   OS_listInsertAfter(&OSstate.TimerList, OSstate.TimerList.Head,
-                     &Timer1.NodeTimer);
+                     timerNode(&Timer1));
   OSstate.TimerIndex = &Timer1.NodeTimer;
   BOOST_CHECK_EQUAL(Timer_isRunning(&Timer1), 1);
 
@@ -103,11 +118,15 @@ BOOST_AUTO_TEST_CASE(start_running_timer) {
   BOOST_CHECK_EQUAL(Timer1.Function, &timerFunction);
   BOOST_CHECK_EQUAL(Timer1.Parameter, (void *)1);
 
-  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, (void *)&OSstate.TimerList);
-  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Previous, (void *)&OSstate.TimerList);
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, listEnd(&OSstate.TimerList));
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Previous, listEnd(&OSstate.TimerList));
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.Value, 1);
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.List, &OSstate.TimerList);
+#if (LIBRERTOS_COMPACT_LISTS == 0)
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.Owner, &Timer1);
+#else
+  BOOST_CHECK_EQUAL(OS_listOwner(timerNode(&Timer1)), &Timer1);
+#endif
 }
 
 BOOST_AUTO_TEST_CASE(reset_stopped_timer) {
@@ -119,12 +138,17 @@ BOOST_AUTO_TEST_CASE(reset_stopped_timer) {
   BOOST_CHECK_EQUAL(Timer1.Function, &timerFunction);
   BOOST_CHECK_EQUAL(Timer1.Parameter, (void *)1);
 
-  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, (void *)&OSstate.TimerUnorderedList);
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next,
+                    listEnd(&OSstate.TimerUnorderedList));
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.Previous,
-                    (void *)&OSstate.TimerUnorderedList);
+                    listEnd(&OSstate.TimerUnorderedList));
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.Value, 0);
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.List, &OSstate.TimerUnorderedList);
+#if (LIBRERTOS_COMPACT_LISTS == 0)
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.Owner, &Timer1);
+#else
+  BOOST_CHECK_EQUAL(OS_listOwner(timerNode(&Timer1)), &Timer1);
+#endif
 }
 
 BOOST_AUTO_TEST_CASE(reset_running_timer) {
@@ -137,19 +161,24 @@ BOOST_AUTO_TEST_CASE(reset_running_timer) {
   BOOST_CHECK_EQUAL(Timer1.Function, &timerFunction);
   BOOST_CHECK_EQUAL(Timer1.Parameter, (void *)1);
 
-  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, (void *)&OSstate.TimerUnorderedList);
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next,
+                    listEnd(&OSstate.TimerUnorderedList));
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.Previous,
-                    (void *)&OSstate.TimerUnorderedList);
+                    listEnd(&OSstate.TimerUnorderedList));
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.Value, 0);
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.List, &OSstate.TimerUnorderedList);
+#if (LIBRERTOS_COMPACT_LISTS == 0)
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.Owner, &Timer1);
+#else
+  BOOST_CHECK_EQUAL(OS_listOwner(timerNode(&Timer1)), &Timer1);
+#endif
 }
 
 BOOST_AUTO_TEST_CASE(reset_running_index_timer) {
   // Manually insert timer on ordered timers list
   Timer1.NodeTimer.Value = (tick_t)(OSstate.Tick + Timer1.Period);
   OS_listInsertAfter(&OSstate.TimerList, OSstate.TimerList.Head,
-                     &Timer1.NodeTimer);
+                     timerNode(&Timer1));
   OSstate.TimerIndex = &Timer1.NodeTimer;
   BOOST_CHECK_EQUAL(Timer_isRunning(&Timer1), 1);
 
@@ -161,12 +190,17 @@ BOOST_AUTO_TEST_CASE(reset_running_index_timer) {
   BOOST_CHECK_EQUAL(Timer1.Function, &timerFunction);
   BOOST_CHECK_EQUAL(Timer1.Parameter, (void *)1);
 
-  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, (void *)&OSstate.TimerUnorderedList);
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next,
+                    listEnd(&OSstate.TimerUnorderedList));
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.Previous,
-                    (void *)&OSstate.TimerUnorderedList);
+                    listEnd(&OSstate.TimerUnorderedList));
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.Value, 1);
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.List, &OSstate.TimerUnorderedList);
+#if (LIBRERTOS_COMPACT_LISTS == 0)
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.Owner, &Timer1);
+#else
+  BOOST_CHECK_EQUAL(OS_listOwner(timerNode(&Timer1)), &Timer1);
+#endif
 }
 
 BOOST_AUTO_TEST_CASE(stop_stopped_timer) {
@@ -178,11 +212,21 @@ BOOST_AUTO_TEST_CASE(stop_stopped_timer) {
   BOOST_CHECK_EQUAL(Timer1.Function, &timerFunction);
   BOOST_CHECK_EQUAL(Timer1.Parameter, (void *)1);
 
-  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, (void *)NULL);
-  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Previous, (void *)NULL);
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.Value, 0);
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.List, (void *)NULL);
+#if (LIBRERTOS_COMPACT_LISTS == 0)
+#if (LIBRERTOS_COMPACT_LISTS == 0)
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, (void *)NULL);
+#else
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, LIST_END);
+#endif
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Previous, (void *)NULL);
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.Owner, &Timer1);
+#else
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, LIST_END);
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Previous, LIST_END);
+  BOOST_CHECK_EQUAL(OS_listOwner(timerNode(&Timer1)), &Timer1);
+#endif
 }
 
 BOOST_AUTO_TEST_CASE(stop_running_timer) {
@@ -195,18 +239,28 @@ BOOST_AUTO_TEST_CASE(stop_running_timer) {
   BOOST_CHECK_EQUAL(Timer1.Function, &timerFunction);
   BOOST_CHECK_EQUAL(Timer1.Parameter, (void *)1);
 
-  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, (void *)NULL);
-  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Previous, (void *)NULL);
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.Value, 0);
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.List, (void *)NULL);
+#if (LIBRERTOS_COMPACT_LISTS == 0)
+#if (LIBRERTOS_COMPACT_LISTS == 0)
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, (void *)NULL);
+#else
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, LIST_END);
+#endif
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Previous, (void *)NULL);
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.Owner, &Timer1);
+#else
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, LIST_END);
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Previous, LIST_END);
+  BOOST_CHECK_EQUAL(OS_listOwner(timerNode(&Timer1)), &Timer1);
+#endif
 }
 
 BOOST_AUTO_TEST_CASE(stop_running_index_timer) {
   // Manually insert timer on ordered timers list
   Timer1.NodeTimer.Value = (tick_t)(OSstate.Tick + Timer1.Period);
   OS_listInsertAfter(&OSstate.TimerList, OSstate.TimerList.Head,
-                     &Timer1.NodeTimer);
+                     timerNode(&Timer1));
   OSstate.TimerIndex = &Timer1.NodeTimer;
   BOOST_CHECK_EQUAL(Timer_isRunning(&Timer1), 1);
 
@@ -218,11 +272,21 @@ BOOST_AUTO_TEST_CASE(stop_running_index_timer) {
   BOOST_CHECK_EQUAL(Timer1.Function, &timerFunction);
   BOOST_CHECK_EQUAL(Timer1.Parameter, (void *)1);
 
-  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, (void *)NULL);
-  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Previous, (void *)NULL);
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.Value, 1);
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.List, (void *)NULL);
+#if (LIBRERTOS_COMPACT_LISTS == 0)
+#if (LIBRERTOS_COMPACT_LISTS == 0)
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, (void *)NULL);
+#else
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, LIST_END);
+#endif
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Previous, (void *)NULL);
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.Owner, &Timer1);
+#else
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, LIST_END);
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Previous, LIST_END);
+  BOOST_CHECK_EQUAL(OS_listOwner(timerNode(&Timer1)), &Timer1);
+#endif
 }
 
 BOOST_AUTO_TEST_CASE(run_oneshot_timer) {
@@ -243,11 +307,21 @@ BOOST_AUTO_TEST_CASE(run_oneshot_timer) {
   BOOST_CHECK_EQUAL(TimerOneShot.Function, &timerFunction);
   BOOST_CHECK_EQUAL(TimerOneShot.Parameter, (void *)20);
 
-  BOOST_CHECK_EQUAL(TimerOneShot.NodeTimer.Next, (void *)NULL);
-  BOOST_CHECK_EQUAL(TimerOneShot.NodeTimer.Previous, (void *)NULL);
   BOOST_CHECK_EQUAL(TimerOneShot.NodeTimer.Value, 0);
   BOOST_CHECK_EQUAL(TimerOneShot.NodeTimer.List, (void *)NULL);
+#if (LIBRERTOS_COMPACT_LISTS == 0)
+#if (LIBRERTOS_COMPACT_LISTS == 0)
+  BOOST_CHECK_EQUAL(TimerOneShot.NodeTimer.Next, (void *)NULL);
+#else
+  BOOST_CHECK_EQUAL(TimerOneShot.NodeTimer.Next, LIST_END);
+#endif
+  BOOST_CHECK_EQUAL(TimerOneShot.NodeTimer.Previous, (void *)NULL);
   BOOST_CHECK_EQUAL(TimerOneShot.NodeTimer.Owner, &TimerOneShot);
+#else
+  BOOST_CHECK_EQUAL(TimerOneShot.NodeTimer.Next, LIST_END);
+  BOOST_CHECK_EQUAL(TimerOneShot.NodeTimer.Previous, LIST_END);
+  BOOST_CHECK_EQUAL(OS_listOwner(timerNode(&TimerOneShot)), &TimerOneShot);
+#endif
 }
 
 BOOST_AUTO_TEST_CASE(run_not_oneshot_timer) {
@@ -265,11 +339,15 @@ BOOST_AUTO_TEST_CASE(run_not_oneshot_timer) {
   BOOST_CHECK_EQUAL(Timer1.Function, &timerFunction);
   BOOST_CHECK_EQUAL(Timer1.Parameter, (void *)1);
 
-  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, (void *)&OSstate.TimerList);
-  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Previous, (void *)&OSstate.TimerList);
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, listEnd(&OSstate.TimerList));
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Previous, listEnd(&OSstate.TimerList));
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.Value, 1);
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.List, (void *)&OSstate.TimerList);
+#if (LIBRERTOS_COMPACT_LISTS == 0)
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.Owner, &Timer1);
+#else
+  BOOST_CHECK_EQUAL(OS_listOwner(timerNode(&Timer1)), &Timer1);
+#endif
 }
 
 BOOST_AUTO_TEST_CASE(no_timer) {
@@ -281,7 +359,7 @@ BOOST_AUTO_TEST_CASE(not_ready_timer) {
   // Manually insert timer on ordered timers list
   Timer1.NodeTimer.Value = (tick_t)(OSstate.Tick + Timer1.Period);
   OS_listInsertAfter(&OSstate.TimerList, OSstate.TimerList.Head,
-                     &Timer1.NodeTimer);
+                     timerNode(&Timer1));
   OSstate.TimerIndex = &Timer1.NodeTimer;
 
   // Run timer task
@@ -296,18 +374,22 @@ BOOST_AUTO_TEST_CASE(not_ready_timer) {
   BOOST_CHECK_EQUAL(Timer1.Function, &timerFunction);
   BOOST_CHECK_EQUAL(Timer1.Parameter, (void *)1);
 
-  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, (void *)&OSstate.TimerList);
-  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Previous, (void *)&OSstate.TimerList);
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, listEnd(&OSstate.TimerList));
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Previous, listEnd(&OSstate.TimerList));
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.Value, 1);
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.List, &OSstate.TimerList);
+#if (LIBRERTOS_COMPACT_LISTS == 0)
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.Owner, &Timer1);
+#else
+  BOOST_CHECK_EQUAL(OS_listOwner(timerNode(&Timer1)), &Timer1);
+#endif
 }
 
 BOOST_AUTO_TEST_CASE(ready_timer) {
   // Manually insert timer on ordered timers list
   Timer1.NodeTimer.Value = (tick_t)(OSstate.Tick + Timer1.Period);
   OS_listInsertAfter(&OSstate.TimerList, OSstate.TimerList.Head,
-                     &Timer1.NodeTimer);
+                     timerNode(&Timer1));
   OSstate.TimerIndex = &Timer1.NodeTimer;
 
   // Run timer task
@@ -324,18 +406,28 @@ BOOST_AUTO_TEST_CASE(ready_timer) {
   BOOST_CHECK_EQUAL(Timer1.Function, &timerFunction);
   BOOST_CHECK_EQUAL(Timer1.Parameter, (void *)1);
 
-  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, (void *)NULL);
-  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Previous, (void *)NULL);
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.Value, 1);
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.List, (void *)NULL);
+#if (LIBRERTOS_COMPACT_LISTS == 0)
+#if (LIBRERTOS_COMPACT_LISTS == 0)
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, (void *)NULL);
+#else
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, LIST_END);
+#endif
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Previous, (void *)NULL);
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.Owner, &Timer1);
+#else
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, LIST_END);
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Previous, LIST_END);
+  BOOST_CHECK_EQUAL(OS_listOwner(timerNode(&Timer1)), &Timer1);
+#endif
 }
 
 BOOST_AUTO_TEST_CASE(ready_auto_timer) {
   // Manually insert timer on ordered timers list
   TimerAuto.NodeTimer.Value = (tick_t)(OSstate.Tick + TimerAuto.Period);
   OS_listInsertAfter(&OSstate.TimerList, OSstate.TimerList.Head,
-                     &TimerAuto.NodeTimer);
+                     timerNode(&TimerAuto));
   OSstate.TimerIndex = &TimerAuto.NodeTimer;
 
   // Run timer task
@@ -353,13 +445,24 @@ BOOST_AUTO_TEST_CASE(ready_auto_timer) {
   BOOST_CHECK_EQUAL(TimerAuto.Function, &timerFunction_Auto);
   BOOST_CHECK_EQUAL(TimerAuto.Parameter, (void *)10);
 
-  BOOST_CHECK_EQUAL(TimerAuto.NodeTimer.Next, (void *)NULL);
-  BOOST_CHECK_EQUAL(TimerAuto.NodeTimer.Previous, (void *)NULL);
   BOOST_CHECK_EQUAL(TimerAuto.NodeTimer.Value, 1);
   BOOST_CHECK_EQUAL(TimerAuto.NodeTimer.List, (void *)NULL);
+#if (LIBRERTOS_COMPACT_LISTS == 0)
+#if (LIBRERTOS_COMPACT_LISTS == 0)
+  BOOST_CHECK_EQUAL(TimerAuto.NodeTimer.Next, (void *)NULL);
+#else
+  BOOST_CHECK_EQUAL(TimerAuto.NodeTimer.Next, LIST_END);
+#endif
+  BOOST_CHECK_EQUAL(TimerAuto.NodeTimer.Previous, (void *)NULL);
   BOOST_CHECK_EQUAL(TimerAuto.NodeTimer.Owner, &TimerAuto);
+#else
+  BOOST_CHECK_EQUAL(TimerAuto.NodeTimer.Next, LIST_END);
+  BOOST_CHECK_EQUAL(TimerAuto.NodeTimer.Previous, LIST_END);
+  BOOST_CHECK_EQUAL(OS_listOwner(timerNode(&TimerAuto)), &TimerAuto);
+#endif
 }
 
+#if (LIBRERTOS_TICK_BITS != 64)
 BOOST_AUTO_TEST_CASE(change_index) {
   OSstate.Tick = MAX_DELAY - 1;
 
@@ -368,13 +471,19 @@ BOOST_AUTO_TEST_CASE(change_index) {
   // Timer1 expires before Tick overflows
   Timer1.NodeTimer.Value = (tick_t)(OSstate.Tick + Timer1.Period);
   OS_listInsertAfter(&OSstate.TimerList, OSstate.TimerList.Head,
-                     &Timer1.NodeTimer);
+                     timerNode(&Timer1));
   OSstate.TimerIndex = &Timer1.NodeTimer;
 
   // Timer2 expires after Tick overflows
   Timer2.NodeTimer.Value = (tick_t)(OSstate.Tick + Timer2.Period);
+#if (LIBRERTOS_COMPACT_LISTS == 0)
   OS_listInsertAfter(&OSstate.TimerList, OSstate.TimerList.Head->Previous,
                      &Timer2.NodeTimer);
+#else
+  OS_listInsertAfter(&OSstate.TimerList,
+                     OS_listNode(OSstate.TimerList.Head)->Previous,
+                     timerNode(&Timer2));
+#endif
 
   // Run timer task
   OS_scheduler();
@@ -399,6 +508,7 @@ BOOST_AUTO_TEST_CASE(change_index) {
   BOOST_CHECK_EQUAL(timerStack.size(), 1);
   BOOST_CHECK_EQUAL(timerStack.top(), &Timer2);
 }
+#endif
 
 BOOST_AUTO_TEST_CASE(concurrent_tick_readies_timer) {
   // Manually insert timer on ordered timers list
@@ -406,7 +516,7 @@ BOOST_AUTO_TEST_CASE(concurrent_tick_readies_timer) {
   // Timer1 expires before Tick overflows
   Timer1.NodeTimer.Value = (tick_t)(OSstate.Tick + Timer1.Period);
   OS_listInsertAfter(&OSstate.TimerList, OSstate.TimerList.Head,
-                     &Timer1.NodeTimer);
+                     timerNode(&Timer1));
   OSstate.TimerIndex = &Timer1.NodeTimer;
 
   TimerOneShot.Function = &timerFunction_UpdateTick;
@@ -429,7 +539,7 @@ BOOST_AUTO_TEST_CASE(concurrent_reset_timer) {
   Timer1.Function = &timerFunction_ResetTimer;
   Timer1.NodeTimer.Value = (tick_t)(OSstate.Tick + Timer1.Period);
   OS_listInsertAfter(&OSstate.TimerList, OSstate.TimerList.Head,
-                     &Timer1.NodeTimer);
+                     timerNode(&Timer1));
   OSstate.TimerIndex = &Timer1.NodeTimer;
 
   // Run timer task
@@ -452,15 +562,15 @@ BOOST_AUTO_TEST_CASE(insert_3_timers_not_overflowed) {
   OS_scheduler();
 
   BOOST_CHECK_EQUAL(OSstate.TimerList.Length, 3);
-  BOOST_CHECK_EQUAL(OSstate.TimerList.Head, &Timer1.NodeTimer);
-  BOOST_CHECK_EQUAL(OSstate.TimerList.Tail, &Timer3.NodeTimer);
+  BOOST_CHECK_EQUAL(OSstate.TimerList.Head, timerNode(&Timer1));
+  BOOST_CHECK_EQUAL(OSstate.TimerList.Tail, timerNode(&Timer3));
 
-  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, &Timer2.NodeTimer);
-  BOOST_CHECK_EQUAL(Timer2.NodeTimer.Next, &Timer3.NodeTimer);
-  BOOST_CHECK_EQUAL(Timer3.NodeTimer.Next,
-                    (struct taskListNode_t *)&OSstate.TimerList);
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, timerNode(&Timer2));
+  BOOST_CHECK_EQUAL(Timer2.NodeTimer.Next, timerNode(&Timer3));
+  BOOST_CHECK_EQUAL(Timer3.NodeTimer.Next, listEnd(&OSstate.TimerList));
 }
 
+#if (LIBRERTOS_TICK_BITS != 64)
 BOOST_AUTO_TEST_CASE(insert_3_timers_overflowed) {
   OSstate.Tick = MAX_DELAY;
 
@@ -472,14 +582,14 @@ BOOST_AUTO_TEST_CASE(insert_3_timers_overflowed) {
   OS_scheduler();
 
   BOOST_CHECK_EQUAL(OSstate.TimerList.Length, 3);
-  BOOST_CHECK_EQUAL(OSstate.TimerList.Head, &Timer1.NodeTimer);
-  BOOST_CHECK_EQUAL(OSstate.TimerList.Tail, &Timer3.NodeTimer);
+  BOOST_CHECK_EQUAL(OSstate.TimerList.Head, timerNode(&Timer1));
+  BOOST_CHECK_EQUAL(OSstate.TimerList.Tail, timerNode(&Timer3));
 
-  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, &Timer2.NodeTimer);
-  BOOST_CHECK_EQUAL(Timer2.NodeTimer.Next, &Timer3.NodeTimer);
-  BOOST_CHECK_EQUAL(Timer3.NodeTimer.Next,
-                    (struct taskListNode_t *)&OSstate.TimerList);
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, timerNode(&Timer2));
+  BOOST_CHECK_EQUAL(Timer2.NodeTimer.Next, timerNode(&Timer3));
+  BOOST_CHECK_EQUAL(Timer3.NodeTimer.Next, listEnd(&OSstate.TimerList));
 }
+#endif
 
 static struct Timer_t *timerToReomve1 = NULL;
 static struct Timer_t *timerToReomve2 = NULL;
@@ -508,13 +618,16 @@ BOOST_AUTO_TEST_CASE(insert_concurrent_remove_pos) {
   librertos_test_set_concurrent_behavior(0);
 
   BOOST_CHECK_EQUAL(OSstate.TimerList.Length, 2);
-  BOOST_CHECK_EQUAL(OSstate.TimerList.Head, &Timer2.NodeTimer);
-  BOOST_CHECK_EQUAL(OSstate.TimerList.Tail, &Timer3.NodeTimer);
+  BOOST_CHECK_EQUAL(OSstate.TimerList.Head, timerNode(&Timer2));
+  BOOST_CHECK_EQUAL(OSstate.TimerList.Tail, timerNode(&Timer3));
 
+#if (LIBRERTOS_COMPACT_LISTS == 0)
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, (void *)NULL);
-  BOOST_CHECK_EQUAL(Timer2.NodeTimer.Next, &Timer3.NodeTimer);
-  BOOST_CHECK_EQUAL(Timer3.NodeTimer.Next,
-                    (struct taskListNode_t *)&OSstate.TimerList);
+#else
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, LIST_END);
+#endif
+  BOOST_CHECK_EQUAL(Timer2.NodeTimer.Next, timerNode(&Timer3));
+  BOOST_CHECK_EQUAL(Timer3.NodeTimer.Next, listEnd(&OSstate.TimerList));
 }
 
 BOOST_AUTO_TEST_CASE(insert_concurrent_remove_node) {
@@ -534,13 +647,128 @@ BOOST_AUTO_TEST_CASE(insert_concurrent_remove_node) {
   librertos_test_set_concurrent_behavior(0);
 
   BOOST_CHECK_EQUAL(OSstate.TimerList.Length, 1);
-  BOOST_CHECK_EQUAL(OSstate.TimerList.Head, &Timer3.NodeTimer);
-  BOOST_CHECK_EQUAL(OSstate.TimerList.Tail, &Timer3.NodeTimer);
+  BOOST_CHECK_EQUAL(OSstate.TimerList.Head, timerNode(&Timer3));
+  BOOST_CHECK_EQUAL(OSstate.TimerList.Tail, timerNode(&Timer3));
 
+#if (LIBRERTOS_COMPACT_LISTS == 0)
   BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, (void *)NULL);
   BOOST_CHECK_EQUAL(Timer2.NodeTimer.Next, (void *)NULL);
-  BOOST_CHECK_EQUAL(Timer3.NodeTimer.Next,
-                    (struct taskListNode_t *)&OSstate.TimerList);
+#else
+  BOOST_CHECK_EQUAL(Timer1.NodeTimer.Next, LIST_END);
+  BOOST_CHECK_EQUAL(Timer2.NodeTimer.Next, LIST_END);
+#endif
+  BOOST_CHECK_EQUAL(Timer3.NodeTimer.Next, listEnd(&OSstate.TimerList));
+}
+
+#if (LIBRERTOS_TIMER_MERGE_QUOTA != 0)
+
+static void runTimerTaskOnce(void) {
+  // Run a single activation of the timer task
+  struct task_t *timerTask = OSstate.Task[1];
+  setCurrentTask(timerTask);
+  timerTask->Function(timerTask->Parameter);
+  setCurrentTask(NULL);
+}
+
+BOOST_AUTO_TEST_CASE(merge_quota_per_activation) {
+  const int n = LIBRERTOS_TIMER_MERGE_QUOTA + 1;
+  struct Timer_t timers[n];
+
+  for (int i = 0; i < n; ++i) {
+    Timer_init(&timers[i], TIMERTYPE_ONESHOT, (tick_t)(n - i), &timerFunction,
+               NULL);
+    Timer_start(&timers[i]);
+  }
+  BOOST_CHECK_EQUAL(OSstate.TimerUnorderedList.Length, n);
+
+  runTimerTaskOnce();
+
+  BOOST_CHECK_EQUAL(OSstate.TimerUnorderedList.Length, 1);
+  BOOST_CHECK_EQUAL(OSstate.TimerList.Length, n - 1);
+
+  runTimerTaskOnce();
+
+  BOOST_CHECK_EQUAL(OSstate.TimerUnorderedList.Length, 0);
+  BOOST_CHECK_EQUAL(OSstate.TimerList.Length, n);
+
+  // Ordered by expiration
+  BOOST_CHECK_EQUAL(OSstate.TimerList.Head, timerNode(&timers[n - 1]));
+  BOOST_CHECK_EQUAL(OSstate.TimerList.Tail, timerNode(&timers[0]));
+}
+
+BOOST_AUTO_TEST_CASE(merge_quota_keeps_timer_task_ready) {
+  const int n = LIBRERTOS_TIMER_MERGE_QUOTA + 1;
+  struct Timer_t timers[n];
+
+  for (int i = 0; i < n; ++i) {
+    Timer_init(&timers[i], TIMERTYPE_ONESHOT, 1, &timerFunction, NULL);
+    Timer_start(&timers[i]);
+  }
+
+  runTimerTaskOnce();
+
+  // Timers still waiting to be merged, timer task must run again
+  BOOST_CHECK_EQUAL(OSstate.Task[1]->State, TASKSTATE_READY);
+}
+
+BOOST_AUTO_TEST_CASE(merge_quota_runs_due_timers_first) {
+  const int n = LIBRERTOS_TIMER_MERGE_QUOTA + 1;
+  struct Timer_t timers[n];
+
+  // Manually insert timer on ordered timers list
+  Timer1.NodeTimer.Value = (tick_t)(OSstate.Tick + Timer1.Period);
+  OS_listInsertAfter(&OSstate.TimerList, OSstate.TimerList.Head,
+                     timerNode(&Timer1));
+  OSstate.TimerIndex = &Timer1.NodeTimer;
+
+  for (int i = 0; i < n; ++i) {
+    Timer_init(&timers[i], TIMERTYPE_ONESHOT, 2, &timerFunction, NULL);
+    Timer_start(&timers[i]);
+  }
+
+  OS_schedulerLock();
+  OS_tick();
+  OS_schedulerUnlock();
+
+  runTimerTaskOnce();
+
+  // Due timer does not wait for the whole burst to be merged
+  BOOST_CHECK_EQUAL(timerStack.size(), 1);
+  BOOST_CHECK_EQUAL(timerStack.top(), &Timer1);
+  BOOST_CHECK_EQUAL(OSstate.TimerUnorderedList.Length, 1);
+}
+
+BOOST_AUTO_TEST_CASE(merge_burst_on_scheduler) {
+  const int n = 3 * LIBRERTOS_TIMER_MERGE_QUOTA + 1;
+  struct Timer_t timers[n];
+
+  for (int i = 0; i < n; ++i) {
+    Timer_init(&timers[i], TIMERTYPE_ONESHOT, (tick_t)(i + 1), &timerFunction,
+               NULL);
+    Timer_start(&timers[i]);
+  }
+
+  // Timer task is re-scheduled until the burst is merged
+  OS_scheduler();
+
+  BOOST_CHECK_EQUAL(OSstate.TimerUnorderedList.Length, 0);
+  BOOST_CHECK_EQUAL(OSstate.TimerList.Length, n);
+
+#if (LIBRERTOS_COMPACT_LISTS == 0)
+  struct taskListNode_t *node = OSstate.TimerList.Head;
+  for (int i = 0; i < n; ++i) {
+    BOOST_CHECK_EQUAL(node, &timers[i].NodeTimer);
+    node = node->Next;
+  }
+#else
+  listIndex_t node = OSstate.TimerList.Head;
+  for (int i = 0; i < n; ++i) {
+    BOOST_REQUIRE_EQUAL(node, timerNode(&timers[i]));
+    node = OS_listNode(node)->Next;
+  }
+#endif
 }
 
+#endif /* LIBRERTOS_TIMER_MERGE_QUOTA */
+
 BOOST_AUTO_TEST_SUITE_END()
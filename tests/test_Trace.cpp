@@ -0,0 +1,274 @@
+#include "LibreRTOS.h"
+#include "OStrace.h"
+#include "TheHeader.h"
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+#include <vector>
+
+#if (LIBRERTOS_TRACE != 0)
+
+/* Built with the kernel trace enabled, without the other options that read
+ US_systemRunTime():
+ scripts/run_config_tests.sh "-DLIBRERTOS_TRACE=1" tests/test_Trace.cpp */
+
+struct TraceFixture {
+  struct task_t Task1;
+  struct Semaphore_t Sem;
+
+  TraceFixture() {
+    OS_init();
+    OS_start();
+
+    Semaphore_init(&Sem, 0, 1);
+  }
+  ~TraceFixture() { BOOST_CHECK_EQUAL(OSstate.SchedulerLock, 0); }
+
+  /* Read all records from the trace buffer. */
+  static std::vector<struct traceRecord_t> readTrace() {
+    std::vector<struct traceRecord_t> records;
+    struct traceRecord_t record;
+
+    while (OS_traceRead(&record, 1) == 1)
+      records.push_back(record);
+
+    return records;
+  }
+
+  /* Records of one event type. */
+  static std::vector<struct traceRecord_t>
+  filterTrace(const std::vector<struct traceRecord_t> &records,
+              enum traceEvent_t event) {
+    std::vector<struct traceRecord_t> filtered;
+
+    for (unsigned i = 0; i < records.size(); ++i)
+      if (records[i].Event == event)
+        filtered.push_back(records[i]);
+
+    return filtered;
+  }
+};
+
+static void taskDelay(void *) {
+  /* Delay so scheduler does not reschedule task to run again. */
+  OS_taskDelay(MAX_DELAY);
+}
+
+static void timerFunction(struct Timer_t *, void *) {}
+
+static std::vector<uint8_t> dumpData;
+
+static void dumpWrite(const void *data, len_t length) {
+  const uint8_t *p = (const uint8_t *)data;
+  dumpData.insert(dumpData.end(), p, p + length);
+}
+
+BOOST_FIXTURE_TEST_SUITE(Trace, TraceFixture)
+
+BOOST_AUTO_TEST_CASE(init_empty) {
+  struct traceRecord_t record;
+
+  BOOST_CHECK_EQUAL(OS_traceRead(&record, 1), 0);
+  BOOST_CHECK_EQUAL(OS_traceLost(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(trace_tick) {
+  OS_schedulerLock();
+  OS_tick();
+  OS_schedulerUnlock();
+
+  std::vector<struct traceRecord_t> ticks = filterTrace(readTrace(), TRACE_TICK);
+
+  BOOST_CHECK_EQUAL(ticks.size(), 1);
+  BOOST_CHECK_EQUAL(ticks[0].Task, -1);
+  BOOST_CHECK_EQUAL(ticks[0].Object, (void *)NULL);
+}
+
+BOOST_AUTO_TEST_CASE(trace_dispatch) {
+  OS_taskCreate(&Task1, 3, &taskDelay, NULL);
+  OS_scheduler();
+
+  std::vector<struct traceRecord_t> records = readTrace();
+  std::vector<struct traceRecord_t> begin =
+      filterTrace(records, TRACE_TASK_BEGIN);
+  std::vector<struct traceRecord_t> end = filterTrace(records, TRACE_TASK_END);
+
+  BOOST_CHECK_EQUAL(begin.size(), 1);
+  BOOST_CHECK_EQUAL(begin[0].Object, &Task1);
+  BOOST_CHECK_EQUAL(begin[0].Task, 3);
+
+  BOOST_CHECK_EQUAL(end.size(), 1);
+  BOOST_CHECK_EQUAL(end[0].Object, &Task1);
+  BOOST_CHECK_EQUAL(end[0].Task, 3);
+
+  BOOST_CHECK_LE(begin[0].Time, end[0].Time);
+}
+
+BOOST_AUTO_TEST_CASE(trace_pend_and_unblock) {
+  OS_taskCreate(&Task1, 2, NULL, NULL);
+  setCurrentTask(&Task1);
+  Semaphore_pend(&Sem, 1);
+  setCurrentTask(NULL);
+
+  Semaphore_give(&Sem);
+
+  std::vector<struct traceRecord_t> records = readTrace();
+  std::vector<struct traceRecord_t> pend = filterTrace(records, TRACE_PEND);
+  std::vector<struct traceRecord_t> give =
+      filterTrace(records, TRACE_SEMAPHORE_GIVE);
+  std::vector<struct traceRecord_t> unblock =
+      filterTrace(records, TRACE_UNBLOCK);
+
+  BOOST_CHECK_EQUAL(pend.size(), 1);
+  BOOST_CHECK_EQUAL(pend[0].Object, &Sem);
+  BOOST_CHECK_EQUAL(pend[0].Task, 2);
+
+  BOOST_CHECK_EQUAL(give.size(), 1);
+  BOOST_CHECK_EQUAL(give[0].Object, &Sem);
+  BOOST_CHECK_EQUAL(give[0].Task, -1);
+
+  BOOST_CHECK_EQUAL(unblock.size(), 1);
+  BOOST_CHECK_EQUAL(unblock[0].Object, &Task1);
+  BOOST_CHECK_EQUAL(unblock[0].Task, 2);
+}
+
+BOOST_AUTO_TEST_CASE(trace_objects) {
+  uint8_t fifoBuff[4];
+  uint8_t queueBuff[4];
+  struct Fifo_t fifo;
+  struct Queue_t queue;
+  struct Mutex_t mtx;
+  uint8_t x = 0;
+
+  Fifo_init(&fifo, fifoBuff, sizeof(fifoBuff));
+  Queue_init(&queue, queueBuff, sizeof(queueBuff), 1);
+  Mutex_init(&mtx);
+
+  OS_taskCreate(&Task1, 0, NULL, NULL);
+  setCurrentTask(&Task1);
+
+  Fifo_write(&fifo, &x, 1);
+  Fifo_read(&fifo, &x, 1);
+  Queue_write(&queue, &x);
+  Queue_read(&queue, &x);
+  Semaphore_give(&Sem);
+  Semaphore_take(&Sem);
+  Mutex_lock(&mtx);
+  Mutex_unlock(&mtx);
+
+  std::vector<struct traceRecord_t> records = readTrace();
+  const enum traceEvent_t events[] = {
+      TRACE_FIFO_WRITE,     TRACE_FIFO_READ,      TRACE_QUEUE_WRITE,
+      TRACE_QUEUE_READ,     TRACE_SEMAPHORE_GIVE, TRACE_SEMAPHORE_TAKE,
+      TRACE_MUTEX_LOCK,     TRACE_MUTEX_UNLOCK};
+  const void *objects[] = {&fifo,  &fifo, &queue, &queue,
+                           &Sem,   &Sem,  &mtx,   &mtx};
+
+  BOOST_CHECK_EQUAL(records.size(), sizeof(events) / sizeof(events[0]));
+
+  for (unsigned i = 0; i < records.size(); ++i) {
+    BOOST_CHECK_EQUAL(records[i].Event, events[i]);
+    BOOST_CHECK_EQUAL(records[i].Object, objects[i]);
+    BOOST_CHECK_EQUAL(records[i].Task, 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(trace_timer) {
+  struct Timer_t timer;
+
+  OS_timerTaskCreate(1);
+  Timer_init(&timer, TIMERTYPE_NOPERIOD, 0, &timerFunction, NULL);
+  Timer_start(&timer);
+  OS_scheduler();
+
+  std::vector<struct traceRecord_t> records = readTrace();
+  std::vector<struct traceRecord_t> begin =
+      filterTrace(records, TRACE_TIMER_BEGIN);
+  std::vector<struct traceRecord_t> end = filterTrace(records, TRACE_TIMER_END);
+
+  BOOST_CHECK_EQUAL(begin.size(), 1);
+  BOOST_CHECK_EQUAL(begin[0].Object, &timer);
+  BOOST_CHECK_EQUAL(begin[0].Task, 1);
+
+  BOOST_CHECK_EQUAL(end.size(), 1);
+  BOOST_CHECK_EQUAL(end[0].Object, &timer);
+  BOOST_CHECK_EQUAL(end[0].Task, 1);
+}
+
+BOOST_AUTO_TEST_CASE(time_order) {
+  OS_taskCreate(&Task1, 0, &taskDelay, NULL);
+  OS_scheduler();
+  Semaphore_give(&Sem);
+  Semaphore_take(&Sem);
+
+  std::vector<struct traceRecord_t> records = readTrace();
+
+  BOOST_CHECK_GT(records.size(), 1);
+  for (unsigned i = 1; i < records.size(); ++i)
+    BOOST_CHECK_LE(records[i - 1].Time, records[i].Time);
+}
+
+BOOST_AUTO_TEST_CASE(overwrite_oldest) {
+  const int extra = 3;
+
+  OS_schedulerLock();
+  for (int i = 0; i < LIBRERTOS_TRACE_LENGTH + extra; ++i)
+    OS_tick();
+  OS_schedulerUnlock();
+
+  BOOST_CHECK_EQUAL(OS_traceLost(), extra);
+
+  /* Buffer keeps the most recent records. */
+  struct traceRecord_t records[LIBRERTOS_TRACE_LENGTH + 1];
+  BOOST_CHECK_EQUAL(OS_traceRead(records, LIBRERTOS_TRACE_LENGTH + 1),
+                    LIBRERTOS_TRACE_LENGTH);
+
+  for (int i = 1; i < LIBRERTOS_TRACE_LENGTH; ++i)
+    BOOST_CHECK_LE(records[i - 1].Time, records[i].Time);
+}
+
+BOOST_AUTO_TEST_CASE(clear) {
+  Semaphore_give(&Sem);
+  OS_traceClear();
+
+  struct traceRecord_t record;
+  BOOST_CHECK_EQUAL(OS_traceRead(&record, 1), 0);
+  BOOST_CHECK_EQUAL(OS_traceLost(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(dump) {
+  Semaphore_give(&Sem);
+  Semaphore_take(&Sem);
+
+  dumpData.clear();
+  OS_traceDump(&dumpWrite);
+
+  /* Header, see scripts/trace_2_chrome_json.py */
+  const unsigned headerSize = 10;
+  const unsigned recordSize =
+      sizeof(stattime_t) + sizeof(void *) + 1 + sizeof(priority_t);
+
+  BOOST_CHECK_EQUAL(dumpData.size(), headerSize + 2 * recordSize);
+  BOOST_CHECK_EQUAL(dumpData[0], 'L');
+  BOOST_CHECK_EQUAL(dumpData[1], 'R');
+  BOOST_CHECK_EQUAL(dumpData[2], 'T');
+  BOOST_CHECK_EQUAL(dumpData[3], 'T');
+  BOOST_CHECK_EQUAL(dumpData[4], 1);
+  BOOST_CHECK_EQUAL(dumpData[5], sizeof(stattime_t));
+  BOOST_CHECK_EQUAL(dumpData[6], sizeof(void *));
+  BOOST_CHECK_EQUAL(dumpData[7], sizeof(priority_t));
+
+  uint16_t byteOrder;
+  std::memcpy(&byteOrder, &dumpData[8], sizeof(byteOrder));
+  BOOST_CHECK_EQUAL(byteOrder, 0x0102);
+
+  /* Event of the first record. */
+  BOOST_CHECK_EQUAL(dumpData[headerSize + sizeof(stattime_t) + sizeof(void *)],
+                    TRACE_SEMAPHORE_GIVE);
+
+  /* Dump does not consume the records. */
+  BOOST_CHECK_EQUAL(readTrace().size(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif /* LIBRERTOS_TRACE */
@@ -0,0 +1,250 @@
+#include "LibreRTOS.h"
+#include "TheHeader.h"
+#include <boost/test/unit_test.hpp>
+#include <thread>
+#include <vector>
+
+#if (LIBRERTOS_WORK_STEALING != 0)
+
+/* Built with multiple instances and work stealing enabled:
+ scripts/run_config_tests.sh \
+     "-DLIBRERTOS_MULTIPLE_INSTANCES=1 -DLIBRERTOS_WORK_STEALING=1 -pthread" */
+
+/* Activation of a migratable task: task and instance it ran on. */
+struct WorkRun {
+  struct task_t *Task;
+  struct libreRtosState_t *Instance;
+};
+
+static std::vector<WorkRun> runs;
+
+static void workFunction(taskParameter_t param) {
+  WorkRun run = {OS_getCurrentTask(), OS_instanceGet()};
+  (void)param;
+  runs.push_back(run);
+}
+
+static void localFunction(taskParameter_t param) {
+  workFunction(param);
+
+  /* Delay so scheduler does not reschedule task to run again. */
+  OS_taskDelay(MAX_DELAY);
+}
+
+struct WorkStealingFixture {
+  static const int NumInstances = 3;
+  static const int NumTasks = 8;
+
+  struct libreRtosState_t *Default;
+  struct libreRtosState_t Instance[NumInstances];
+  struct WorkPool_t Pool;
+
+  struct task_t Work[NumTasks];
+  struct task_t Local;
+
+  WorkStealingFixture() {
+    runs.clear();
+    Default = OS_instanceGet();
+
+    OS_workPoolInit(&Pool);
+
+    for (int i = 0; i < NumInstances; ++i) {
+      OS_instanceSelect(&Instance[i]);
+      OS_init();
+      OS_workPoolJoin(&Pool);
+      OS_start();
+    }
+
+    for (int i = 0; i < NumTasks; ++i)
+      OS_taskCreateMigratable(&Work[i], &workFunction, NULL);
+  }
+  ~WorkStealingFixture() {
+    for (int i = 0; i < NumInstances; ++i) {
+      OS_instanceSelect(&Instance[i]);
+      BOOST_CHECK_EQUAL(OSstate.SchedulerLock, 0);
+    }
+
+    OS_instanceSelect(Default);
+  }
+
+  void submit(int instance, int first, int count) {
+    OS_instanceSelect(&Instance[instance]);
+    for (int i = first; i < first + count; ++i)
+      BOOST_CHECK_EQUAL(OS_taskSubmit(&Work[i]), 1);
+  }
+};
+
+const int WorkStealingFixture::NumInstances;
+
+BOOST_FIXTURE_TEST_SUITE(WorkStealing, WorkStealingFixture)
+
+BOOST_AUTO_TEST_CASE(pool_join) {
+  BOOST_CHECK_EQUAL(Pool.Count, NumInstances);
+  for (int i = 0; i < NumInstances; ++i)
+    BOOST_CHECK_EQUAL(Pool.Instance[i], &Instance[i]);
+}
+
+BOOST_AUTO_TEST_CASE(migratable_not_in_task_table) {
+  for (int i = 0; i < NumInstances; ++i)
+    for (int j = 0; j < LIBRERTOS_MAX_PRIORITY; ++j)
+      BOOST_CHECK(Instance[i].Task[j] == NULL);
+}
+
+BOOST_AUTO_TEST_CASE(run_on_own_instance) {
+  submit(0, 0, 1);
+
+  BOOST_CHECK_EQUAL(OS_workPending(), 1);
+
+  OS_scheduler();
+
+  BOOST_REQUIRE_EQUAL(runs.size(), 1);
+  BOOST_CHECK_EQUAL(runs[0].Task, &Work[0]);
+  BOOST_CHECK_EQUAL(runs[0].Instance, &Instance[0]);
+  BOOST_CHECK_EQUAL(OS_workPending(), 0);
+  BOOST_CHECK_EQUAL(OS_workStolen(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(own_work_last_submitted_first) {
+  submit(0, 0, 3);
+
+  OS_scheduler();
+
+  BOOST_REQUIRE_EQUAL(runs.size(), 3);
+  BOOST_CHECK_EQUAL(runs[0].Task, &Work[2]);
+  BOOST_CHECK_EQUAL(runs[1].Task, &Work[1]);
+  BOOST_CHECK_EQUAL(runs[2].Task, &Work[0]);
+}
+
+BOOST_AUTO_TEST_CASE(idle_instance_steals) {
+  submit(0, 0, 3);
+
+  OS_instanceSelect(&Instance[1]);
+  OS_scheduler();
+
+  /* Stolen oldest first, the opposite end of the owner. */
+  BOOST_REQUIRE_EQUAL(runs.size(), 3);
+  for (int i = 0; i < 3; ++i) {
+    BOOST_CHECK_EQUAL(runs[i].Task, &Work[i]);
+    BOOST_CHECK_EQUAL(runs[i].Instance, &Instance[1]);
+  }
+  BOOST_CHECK_EQUAL(OS_workStolen(), 3);
+
+  OS_instanceSelect(&Instance[0]);
+  BOOST_CHECK_EQUAL(OS_workPending(), 0);
+  BOOST_CHECK_EQUAL(OS_workStolen(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(steal_from_busiest) {
+  submit(0, 0, 1);
+  submit(2, 1, 3);
+
+  OS_instanceSelect(&Instance[1]);
+  OS_scheduler();
+
+  BOOST_REQUIRE_EQUAL(runs.size(), 4);
+  BOOST_CHECK_EQUAL(runs[0].Task, &Work[1]);
+}
+
+BOOST_AUTO_TEST_CASE(ready_tasks_before_stealing) {
+  submit(0, 0, 1);
+
+  OS_instanceSelect(&Instance[1]);
+  OS_taskCreate(&Local, 0, &localFunction, NULL);
+  OS_scheduler();
+
+  /* Local task runs first, even at the lowest priority. After it the
+   instance is idle and steals. */
+  BOOST_REQUIRE_EQUAL(runs.size(), 2);
+  BOOST_CHECK_EQUAL(runs[0].Task, &Local);
+  BOOST_CHECK_EQUAL(runs[1].Task, &Work[0]);
+}
+
+BOOST_AUTO_TEST_CASE(submit_full) {
+  struct task_t more[LIBRERTOS_WORK_DEQUE_LENGTH + 1];
+
+  OS_instanceSelect(&Instance[0]);
+  for (int i = 0; i <= LIBRERTOS_WORK_DEQUE_LENGTH; ++i)
+    OS_taskCreateMigratable(&more[i], &workFunction, NULL);
+
+  for (int i = 0; i < LIBRERTOS_WORK_DEQUE_LENGTH; ++i)
+    BOOST_CHECK_EQUAL(OS_taskSubmit(&more[i]), 1);
+
+  BOOST_CHECK_EQUAL(OS_taskSubmit(&more[LIBRERTOS_WORK_DEQUE_LENGTH]), 0);
+  BOOST_CHECK_EQUAL(OS_workPending(), LIBRERTOS_WORK_DEQUE_LENGTH);
+
+  OS_scheduler();
+
+  BOOST_CHECK_EQUAL(runs.size(), (size_t)LIBRERTOS_WORK_DEQUE_LENGTH);
+}
+
+BOOST_AUTO_TEST_CASE(submit_not_migratable) {
+  OS_instanceSelect(&Instance[0]);
+  OS_taskCreate(&Local, 0, &workFunction, NULL);
+
+  BOOST_CHECK_THROW(OS_taskSubmit(&Local), int);
+}
+
+BOOST_AUTO_TEST_CASE(submit_not_joined) {
+  struct libreRtosState_t alone;
+
+  OS_instanceSelect(&alone);
+  OS_init();
+  OS_start();
+
+  BOOST_CHECK_THROW(OS_taskSubmit(&Work[0]), int);
+  BOOST_CHECK_EQUAL(alone.SchedulerLock, 0);
+}
+
+BOOST_AUTO_TEST_CASE(threads) {
+  const int numWork = LIBRERTOS_WORK_DEQUE_LENGTH;
+  struct task_t work[numWork];
+  static volatile int done;
+  static int ranOn[numWork];
+  std::vector<std::thread> threads;
+
+  struct local {
+    static void function(taskParameter_t param) {
+      ranOn[(long)param] += 1;
+      __sync_fetch_and_add(&done, 1);
+    }
+  };
+
+  done = 0;
+  for (int i = 0; i < numWork; ++i) {
+    ranOn[i] = 0;
+    OS_taskCreateMigratable(&work[i], &local::function, (void *)(long)i);
+  }
+
+  /* All the work submitted to one instance, the others steal it. */
+  OS_instanceSelect(&Instance[0]);
+  for (int i = 0; i < numWork; ++i)
+    OS_taskSubmit(&work[i]);
+
+  for (int i = 0; i < NumInstances; ++i)
+    threads.push_back(std::thread([this, i]() {
+      OS_instanceSelect(&Instance[i]);
+      while (done < numWork)
+        OS_scheduler();
+    }));
+
+  for (size_t i = 0; i < threads.size(); ++i)
+    threads[i].join();
+
+  /* Each task ran exactly once. */
+  for (int i = 0; i < numWork; ++i)
+    BOOST_CHECK_EQUAL(ranOn[i], 1);
+
+  statcount_t stolen = 0;
+  for (int i = 0; i < NumInstances; ++i) {
+    OS_instanceSelect(&Instance[i]);
+    BOOST_CHECK_EQUAL(OS_workPending(), 0);
+    stolen += OS_workStolen();
+  }
+  OS_instanceSelect(&Instance[0]);
+  BOOST_CHECK_EQUAL(OS_workStolen(), 0);
+  BOOST_CHECK_LE(stolen, (statcount_t)numWork);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif /* LIBRERTOS_WORK_STEALING */
@@ -1,5 +1,7 @@
 #include "LibreRTOS.h"
+#include "TheHeader.h"
 #include <boost/test/unit_test.hpp>
+#include <vector>
 
 struct test_func__OS_scheduler__Fixture {
   struct task_t Task1;
@@ -46,6 +48,21 @@ void taskCompletionDelay(void *) {
   }
 }
 
+#if (LIBRERTOS_IDLE_HOOK != 0)
+static std::vector<tick_t> idleTicks;
+void idleRecord(tick_t ticks) { idleTicks.push_back(ticks); }
+
+static std::vector<tick_t> delayTicks;
+void taskDelayParam(void *param) {
+  /* Idle hook is not called while the task runs. */
+  delayTicks.push_back((tick_t)idleTicks.size());
+
+  OS_taskDelay((tick_t)(long)param);
+}
+
+void idleRunTime(tick_t) { librertos_test_add_run_time(100); }
+#endif
+
 BOOST_FIXTURE_TEST_SUITE(func__OS_scheduler, test_func__OS_scheduler__Fixture)
 
 BOOST_AUTO_TEST_CASE(run_scheduler_with_no_tasks) { OS_scheduler(); }
@@ -94,4 +111,167 @@ BOOST_AUTO_TEST_CASE(assert_if_task_already_created) {
   BOOST_CHECK_THROW(OS_taskCreate(&Task2, priority, NULL, 0), int);
 }
 
+#if (LIBRERTOS_IDLE_HOOK != 0)
+/* Built with the idle hook enabled, with statistics for the idle time:
+ scripts/run_config_tests.sh \
+     "-DLIBRERTOS_IDLE_HOOK=1 -DLIBRERTOS_STATISTICS=1" \
+     tests/test_func__OS_scheduler.cpp */
+
+BOOST_AUTO_TEST_CASE(idle_hook_no_tasks) {
+  idleTicks.clear();
+  librertos_test_set_idle_behavior(&idleRecord);
+
+  OS_scheduler();
+
+  librertos_test_set_idle_behavior(NULL);
+
+  /* Nothing to wake up. */
+  BOOST_REQUIRE_EQUAL(idleTicks.size(), 1);
+  BOOST_CHECK_EQUAL(idleTicks[0], MAX_DELAY);
+}
+
+BOOST_AUTO_TEST_CASE(idle_hook_after_tasks) {
+  idleTicks.clear();
+  delayTicks.clear();
+  OS_taskCreate(&Task1, 0, &taskDelayParam, (void *)5);
+  OS_taskCreate(&Task2, 1, &taskDelayParam, (void *)3);
+  librertos_test_set_idle_behavior(&idleRecord);
+
+  OS_scheduler();
+
+  librertos_test_set_idle_behavior(NULL);
+
+  /* Called once, after both tasks, with the ticks to the next wake up. */
+  BOOST_REQUIRE_EQUAL(delayTicks.size(), 2);
+  BOOST_CHECK_EQUAL(delayTicks[0], 0);
+  BOOST_CHECK_EQUAL(delayTicks[1], 0);
+  BOOST_REQUIRE_EQUAL(idleTicks.size(), 1);
+  BOOST_CHECK_EQUAL(idleTicks[0], 3);
+}
+
+BOOST_AUTO_TEST_CASE(idle_hook_ticks_elapsed) {
+  idleTicks.clear();
+  delayTicks.clear();
+  OS_taskCreate(&Task1, 0, &taskDelayParam, (void *)5);
+  OS_scheduler();
+
+  librertos_test_set_idle_behavior(&idleRecord);
+
+  OS_tick();
+  OS_tick();
+  OS_scheduler();
+
+  /* Ticks processed before the hook, task wakes up at tick 5. */
+  OS_tick();
+  OS_tick();
+  OS_tick();
+  OS_scheduler();
+
+  librertos_test_set_idle_behavior(NULL);
+
+  BOOST_REQUIRE_EQUAL(idleTicks.size(), 2);
+  BOOST_CHECK_EQUAL(idleTicks[0], 3);
+  BOOST_CHECK_EQUAL(delayTicks.size(), 2);
+  BOOST_CHECK_EQUAL(idleTicks[1], 5);
+}
+
+#if (LIBRERTOS_TICK_BITS != 64)
+BOOST_AUTO_TEST_CASE(idle_hook_delay_overflowed) {
+  idleTicks.clear();
+  OSstate.Tick = (tick_t)(MAX_DELAY - 2);
+  OS_taskCreate(&Task1, 0, &taskDelayParam, (void *)5);
+
+  librertos_test_set_idle_behavior(&idleRecord);
+  OS_scheduler();
+  librertos_test_set_idle_behavior(NULL);
+
+  /* Wake up tick count wrapped around to 2. */
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.List, OSstate.BlockedTaskList_Overflowed);
+  BOOST_REQUIRE_EQUAL(idleTicks.size(), 1);
+  BOOST_CHECK_EQUAL(idleTicks[0], 5);
+}
+#endif
+
+#if (LIBRERTOS_SOFTWARETIMERS != 0)
+static void timerNothing(struct Timer_t *, void *) {}
+
+BOOST_AUTO_TEST_CASE(idle_hook_timer) {
+  struct Timer_t timer;
+
+  idleTicks.clear();
+  OS_timerTaskCreate(LIBRERTOS_MAX_PRIORITY - 1);
+  Timer_init(&timer, TIMERTYPE_AUTO, 4, &timerNothing, NULL);
+  Timer_start(&timer);
+
+  librertos_test_set_idle_behavior(&idleRecord);
+  OS_scheduler();
+  librertos_test_set_idle_behavior(NULL);
+
+  BOOST_REQUIRE_EQUAL(idleTicks.size(), 1);
+  BOOST_CHECK_EQUAL(idleTicks[0], 4);
+}
+#endif
+
+BOOST_AUTO_TEST_CASE(idle_hook_not_called_nested) {
+  idleTicks.clear();
+  taskScheduleCount = 0;
+  OS_taskCreate(&Task1, LIBRERTOS_MAX_PRIORITY - 1, &taskSchedule, 0);
+  librertos_test_set_idle_behavior(&idleRecord);
+
+  OS_scheduler();
+
+  librertos_test_set_idle_behavior(NULL);
+
+  /* Not idle while a task calls the scheduler. */
+  BOOST_CHECK_EQUAL(taskScheduleCount, 1);
+  BOOST_CHECK_EQUAL(idleTicks.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(idle_hook_not_called_scheduler_locked) {
+  idleTicks.clear();
+  librertos_test_set_idle_behavior(&idleRecord);
+
+  OS_schedulerLock();
+  OS_scheduler();
+  OS_schedulerUnlock();
+
+  librertos_test_set_idle_behavior(NULL);
+
+  BOOST_CHECK_EQUAL(idleTicks.size(), 0);
+}
+
+#if (LIBRERTOS_STATISTICS != 0)
+BOOST_AUTO_TEST_CASE(idle_run_time) {
+  stattime_t idle = OS_getIdleRunTime();
+
+  librertos_test_set_idle_behavior(&idleRunTime);
+  OS_scheduler();
+  librertos_test_set_idle_behavior(NULL);
+
+  /* Measured around the hook, part of the no-task time. */
+  BOOST_CHECK_GE(OS_getIdleRunTime() - idle, 100);
+  BOOST_CHECK_LT(OS_getIdleRunTime() - idle, 200);
+  BOOST_CHECK_LE(OS_getIdleRunTime(), OS_getNoTaskRunTime());
+}
+
+BOOST_AUTO_TEST_CASE(idle_load) {
+  struct OSstatistics_t start;
+  struct OSstatistics_t end;
+
+  OS_getStatistics(&start);
+  librertos_test_set_idle_behavior(&idleRunTime);
+  OS_scheduler();
+  librertos_test_set_idle_behavior(NULL);
+  OS_getStatistics(&end);
+
+  /* Load in parts per thousand, CPU load is 1000 minus the idle load. */
+  BOOST_CHECK_EQUAL(end.IdleRunTime, OS_getIdleRunTime());
+  BOOST_CHECK_GT(OS_statisticsIdleLoad(&start, &end), 900);
+  BOOST_CHECK_LE(OS_statisticsIdleLoad(&start, &end),
+                 OS_statisticsNoTaskLoad(&start, &end));
+  BOOST_CHECK_EQUAL(OS_statisticsIdleLoad(&end, &end), 0);
+}
+#endif
+#endif
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -1,4 +1,5 @@
 #include "LibreRTOS.h"
+#include "OSevent.h"
 #include "OSlist.h"
 #include "TheHeader.h"
 #include <boost/test/unit_test.hpp>
@@ -16,6 +17,14 @@ struct test_func__OS_schedulerUnlock__Fixture {
   }
 };
 
+static int taskRunCount = 0;
+static void taskRun(void *) {
+  ++taskRunCount;
+
+  /* Delay so scheduler does not reschedule task to run again. */
+  OS_taskDelay(MAX_DELAY);
+}
+
 BOOST_FIXTURE_TEST_SUITE(func__OS_schedulerUnlock,
                          test_func__OS_schedulerUnlock__Fixture)
 
@@ -45,6 +54,7 @@ BOOST_AUTO_TEST_CASE(process_delayed_ticks) {
   BOOST_CHECK_EQUAL(OSstate.DelayedTicks, 0);
 }
 
+#if (LIBRERTOS_TICK_BITS != 64)
 BOOST_AUTO_TEST_CASE(invert_blocked_tasks_list) {
   OS_schedulerLock();
   OSstate.Tick = MAX_DELAY;
@@ -62,6 +72,7 @@ BOOST_AUTO_TEST_CASE(invert_blocked_tasks_list) {
   BOOST_CHECK_EQUAL(OSstate.BlockedTaskList_Overflowed,
                     &OSstate.BlockedTaskList1);
 }
+#endif
 
 BOOST_AUTO_TEST_CASE(task_not_unblocked_by_tick) {
   OS_taskCreate(&Task1, 0, 0, 0);
@@ -147,7 +158,7 @@ BOOST_AUTO_TEST_CASE(task_unblocked_from_event_by_tick) {
   OS_taskCreate(&Task1, 0, 0, 0);
   setCurrentTask(&Task1);
 
-  OS_listInsertAfter(&list, list.Head, &Task1.NodeEvent);
+  OS_listInsertAfter(&list, list.Head, eventNode(&Task1));
   Task1.State = TASKSTATE_SUSPENDED;
 
   OS_schedulerLock();
@@ -177,7 +188,7 @@ BOOST_AUTO_TEST_CASE(
   OS_taskCreate(&Task1, 0, 0, 0);
   setCurrentTask(&Task1);
 
-  OS_listInsertAfter(list, list->Head, &Task1.NodeEvent);
+  OS_listInsertAfter(list, list->Head, eventNode(&Task1));
   Task1.State = TASKSTATE_SUSPENDED;
   OSstate.SchedulerUnlockTodo = 1;
 
@@ -204,7 +215,7 @@ BOOST_AUTO_TEST_CASE(
   OS_taskCreate(&Task2, 0, 0, 0);
 
   setCurrentTask(&Task1);
-  OS_listInsertAfter(list, list->Head, &Task1.NodeEvent);
+  OS_listInsertAfter(list, list->Head, eventNode(&Task1));
   Task1.State = TASKSTATE_SUSPENDED;
   OSstate.SchedulerUnlockTodo = 1;
 
@@ -230,7 +241,7 @@ BOOST_AUTO_TEST_CASE(task_unblock_blocked_pending_ready_task) {
   setCurrentTask(&Task1);
 
   OS_taskDelay(1);
-  OS_listInsertAfter(list, list->Head, &Task1.NodeEvent);
+  OS_listInsertAfter(list, list->Head, eventNode(&Task1));
   OSstate.SchedulerUnlockTodo = 1;
 
   OS_schedulerLock();
@@ -260,4 +271,118 @@ BOOST_AUTO_TEST_CASE(get_gick_count) {
   BOOST_CHECK_EQUAL(OS_getTickCount(), n);
 }
 
+BOOST_AUTO_TEST_CASE(interrupt_nesting) {
+  BOOST_CHECK_EQUAL(OSstate.InterruptNesting, 0);
+  OS_interruptEnter();
+  BOOST_CHECK_EQUAL(OSstate.InterruptNesting, 1);
+  OS_interruptEnter();
+  BOOST_CHECK_EQUAL(OSstate.InterruptNesting, 2);
+  OS_interruptExit();
+  BOOST_CHECK_EQUAL(OSstate.InterruptNesting, 1);
+  OS_interruptExit();
+  BOOST_CHECK_EQUAL(OSstate.InterruptNesting, 0);
+}
+
+BOOST_AUTO_TEST_CASE(tick_in_interrupt_is_delayed) {
+  OS_interruptEnter();
+  OS_tick();
+  OS_interruptExit();
+
+  BOOST_CHECK_EQUAL(OSstate.Tick, 0);
+  BOOST_CHECK_EQUAL(OSstate.DelayedTicks, 1);
+
+  OS_schedulerLock();
+  OS_schedulerUnlock();
+
+  BOOST_CHECK_EQUAL(OSstate.Tick, 1);
+  BOOST_CHECK_EQUAL(OSstate.DelayedTicks, 0);
+}
+
+BOOST_AUTO_TEST_CASE(task_unblocked_in_interrupt_stays_pending_ready) {
+  struct Semaphore_t sem;
+
+  Semaphore_init(&sem, 0, 1);
+
+  OS_taskCreate(&Task1, 0, 0, 0);
+  setCurrentTask(&Task1);
+  Semaphore_pend(&sem, 10);
+  setCurrentTask(NULL);
+
+  OS_interruptEnter();
+  BOOST_CHECK_EQUAL(Semaphore_give(&sem), 1);
+  OS_interruptExit();
+
+  /* Only moved to the pending ready list by the interrupt. */
+  BOOST_CHECK_EQUAL(Task1.State, TASKSTATE_BLOCKED);
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.List, &OSstate.BlockedTaskList1);
+  BOOST_CHECK_EQUAL(Task1.NodeEvent.List, &OSstate.PendingReadyTaskList);
+  BOOST_CHECK_EQUAL(OSstate.SchedulerUnlockTodo, 1);
+
+  OS_schedulerLock();
+  OS_schedulerUnlock();
+
+  BOOST_CHECK_EQUAL(Task1.State, TASKSTATE_READY);
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.List, (void *)0);
+  BOOST_CHECK_EQUAL(Task1.NodeEvent.List, (void *)0);
+}
+
+BOOST_AUTO_TEST_CASE(tasks_unblocked_in_interrupt_drained_by_unlock) {
+  struct task_t tasks[3];
+  struct eventR_t event;
+
+  OS_eventRInit(&event);
+
+  for (int i = 0; i < 3; ++i) {
+    OS_taskCreate(&tasks[i], (priority_t)i, 0, 0);
+    setCurrentTask(&tasks[i]);
+    OS_eventPrePendTask(&event.ListRead, &tasks[i]);
+    OS_eventPendTask(&event.ListRead, &tasks[i], MAX_DELAY);
+  }
+  setCurrentTask(NULL);
+
+  OS_interruptEnter();
+  for (int i = 0; i < 3; ++i)
+    OS_eventUnblockTasks(&event.ListRead);
+  OS_interruptExit();
+
+  BOOST_CHECK_EQUAL(event.ListRead.Length, 0);
+  BOOST_CHECK_EQUAL(OSstate.PendingReadyTaskList.Length, 3);
+  for (int i = 0; i < 3; ++i)
+    BOOST_CHECK_EQUAL(tasks[i].State, TASKSTATE_BLOCKED);
+
+  OS_schedulerLock();
+  OS_schedulerUnlock();
+
+  BOOST_CHECK_EQUAL(OSstate.PendingReadyTaskList.Length, 0);
+  for (int i = 0; i < 3; ++i) {
+    BOOST_CHECK_EQUAL(tasks[i].State, TASKSTATE_READY);
+    BOOST_CHECK_EQUAL(tasks[i].NodeDelay.List, (void *)0);
+    BOOST_CHECK_EQUAL(tasks[i].NodeEvent.List, (void *)0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(task_unblocked_in_interrupt_runs_on_scheduler) {
+  struct Semaphore_t sem;
+
+  Semaphore_init(&sem, 0, 1);
+
+  taskRunCount = 0;
+  OS_taskCreate(&Task1, 0, &taskRun, 0);
+  setCurrentTask(&Task1);
+  Semaphore_pend(&sem, 10);
+  setCurrentTask(NULL);
+
+  OS_interruptEnter();
+  Semaphore_give(&sem);
+
+  /* No task runs in interrupt context. */
+  OS_scheduler();
+  BOOST_CHECK_EQUAL(taskRunCount, 0);
+
+  OS_interruptExit();
+
+  OS_scheduler();
+  BOOST_CHECK_EQUAL(taskRunCount, 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
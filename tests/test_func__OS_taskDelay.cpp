@@ -48,7 +48,12 @@ BOOST_AUTO_TEST_CASE(delay_max_ticks) {
   OS_taskDelay(MAX_DELAY);
 
   BOOST_CHECK_EQUAL(Task1.State, TASKSTATE_BLOCKED);
+#if (LIBRERTOS_TICK_BITS != 64)
   BOOST_CHECK_EQUAL(Task1.NodeDelay.List, &OSstate.BlockedTaskList2);
+#else
+  /* Tick count never overflows, single blocked task list. */
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.List, &OSstate.BlockedTaskList1);
+#endif
 }
 
 BOOST_AUTO_TEST_CASE(resume_blocked_task) {
@@ -74,7 +79,7 @@ BOOST_AUTO_TEST_CASE(resume_suspended_task) {
   OS_taskCreate(&Task1, 0, 0, 0);
   setCurrentTask(&Task1);
 
-  OS_listInsertAfter(&list, list.Head, &Task1.NodeEvent);
+  OS_listInsertAfter(&list, list.Head, eventNode(&Task1));
 
   OS_taskDelay(1);
 
@@ -89,4 +94,121 @@ BOOST_AUTO_TEST_CASE(resume_suspended_task) {
   BOOST_CHECK_EQUAL(Task1.NodeEvent.List, (void *)0);
 }
 
+BOOST_AUTO_TEST_CASE(delay_until) {
+  tick_t lastWake = 0;
+
+  OS_taskCreate(&Task1, 0, 0, 0);
+  setCurrentTask(&Task1);
+
+  BOOST_CHECK_EQUAL(OS_taskDelayUntil(&lastWake, 10), 1);
+
+  BOOST_CHECK_EQUAL(lastWake, 10);
+  BOOST_CHECK_EQUAL(Task1.State, TASKSTATE_BLOCKED);
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.List, &OSstate.BlockedTaskList1);
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.Value, 10);
+}
+
+BOOST_AUTO_TEST_CASE(delay_until_no_drift) {
+  tick_t lastWake = 0;
+
+  OS_taskCreate(&Task1, 0, 0, 0);
+  setCurrentTask(&Task1);
+
+  /* Task ran for 3 ticks, wakes at the period and not 3 ticks later. */
+  OSstate.Tick = 3;
+  BOOST_CHECK_EQUAL(OS_taskDelayUntil(&lastWake, 10), 1);
+
+  BOOST_CHECK_EQUAL(lastWake, 10);
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.Value, 10);
+}
+
+BOOST_AUTO_TEST_CASE(delay_until_wake_now) {
+  tick_t lastWake = 0;
+
+  OS_taskCreate(&Task1, 0, 0, 0);
+  setCurrentTask(&Task1);
+
+  OSstate.Tick = 10;
+  BOOST_CHECK_EQUAL(OS_taskDelayUntil(&lastWake, 10), 1);
+
+  BOOST_CHECK_EQUAL(lastWake, 10);
+  BOOST_CHECK_EQUAL(Task1.State, TASKSTATE_READY);
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.List, (void *)0);
+}
+
+BOOST_AUTO_TEST_CASE(delay_until_overrun) {
+  tick_t lastWake = 0;
+
+  OS_taskCreate(&Task1, 0, 0, 0);
+  setCurrentTask(&Task1);
+
+  /* Wake tick already past: not delayed, overrun reported. */
+  OSstate.Tick = 15;
+  BOOST_CHECK_EQUAL(OS_taskDelayUntil(&lastWake, 10), 0);
+
+  BOOST_CHECK_EQUAL(lastWake, 10);
+  BOOST_CHECK_EQUAL(Task1.State, TASKSTATE_READY);
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.List, (void *)0);
+
+  /* The period keeps its phase. */
+  BOOST_CHECK_EQUAL(OS_taskDelayUntil(&lastWake, 10), 1);
+
+  BOOST_CHECK_EQUAL(lastWake, 20);
+  BOOST_CHECK_EQUAL(Task1.State, TASKSTATE_BLOCKED);
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.Value, 20);
+}
+
+BOOST_AUTO_TEST_CASE(delay_until_periodic) {
+  tick_t lastWake = 0;
+
+  OS_taskCreate(&Task1, 0, 0, 0);
+
+  for (tick_t period = 1; period <= 3; ++period) {
+    setCurrentTask(&Task1);
+    OS_taskDelayUntil(&lastWake, 5);
+    setCurrentTask(NULL);
+
+    while (Task1.State == TASKSTATE_BLOCKED) {
+      OS_tick();
+      OS_schedulerLock();
+      OS_schedulerUnlock();
+    }
+
+    BOOST_CHECK_EQUAL(OSstate.Tick, period * 5);
+  }
+}
+
+#if (LIBRERTOS_TICK_BITS != 64)
+BOOST_AUTO_TEST_CASE(delay_until_tick_overflow) {
+  tick_t lastWake = MAX_DELAY - 5;
+
+  OS_taskCreate(&Task1, 0, 0, 0);
+  setCurrentTask(&Task1);
+
+  OSstate.Tick = MAX_DELAY - 2;
+  BOOST_CHECK_EQUAL(OS_taskDelayUntil(&lastWake, 10), 1);
+
+  BOOST_CHECK_EQUAL(lastWake, 4);
+  BOOST_CHECK_EQUAL(Task1.State, TASKSTATE_BLOCKED);
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.List,
+                    OSstate.BlockedTaskList_Overflowed);
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.Value, 4);
+}
+
+BOOST_AUTO_TEST_CASE(delay_until_overrun_tick_overflow) {
+  tick_t lastWake = MAX_DELAY - 20;
+
+  OS_taskCreate(&Task1, 0, 0, 0);
+  setCurrentTask(&Task1);
+
+  /* Wake tick is before the overflow, now is after it. */
+  OSstate.Tick = 2;
+  BOOST_CHECK_EQUAL(OS_taskDelayUntil(&lastWake, 10), 0);
+
+  BOOST_CHECK_EQUAL(lastWake, (tick_t)(MAX_DELAY - 10));
+  BOOST_CHECK_EQUAL(Task1.State, TASKSTATE_READY);
+  BOOST_CHECK_EQUAL(Task1.NodeDelay.List, (void *)0);
+}
+#endif
+
 BOOST_AUTO_TEST_SUITE_END()